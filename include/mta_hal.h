@@ -91,6 +91,10 @@
 #define RETURN_ERR   -1
 #endif
 
+#ifndef RETURN_TIMEOUT
+#define RETURN_TIMEOUT   -2
+#endif
+
 #ifndef IPV4_ADDRESS_SIZE
 #define  IPV4_ADDRESS_SIZE                          4
 #endif
@@ -247,6 +251,66 @@ typedef struct _MTAMGMT_MTA_DHCPv6_INFO
     CHAR SecondaryDHCPv6Server[INET6_ADDRSTRLEN];      /**< Secondary DHCPv6 server IPv6 address. */
 } MTAMGMT_MTA_DHCPv6_INFO, *PMTAMGMT_MTA_DHCPv6_INFO;
 
+/**
+ * @brief Structure representing DHCP information for an MTA in binary form.
+ *
+ * Same content as MTAMGMT_MTA_DHCP_INFO, with the lease timers and MAC address as integers so that no text parsing is needed.
+ * Addresses are held in network byte order.
+ *
+ * @note Ensure that any value specified does not exceed the buffer size limit defined.
+ */
+typedef struct _MTAMGMT_MTA_DHCP_INFO_BIN
+{
+    ANSC_IPV4_ADDRESS IPAddress;               /**< IP Address assigned to the MTA. */
+    ANSC_IPV4_ADDRESS SubnetMask;              /**< Subnet mask for the IP address. */
+    ANSC_IPV4_ADDRESS Gateway;                 /**< Default gateway IP address. */
+    ANSC_IPV4_ADDRESS PrimaryDNS;              /**< Primary DNS server IP address. */
+    ANSC_IPV4_ADDRESS SecondaryDNS;            /**< Secondary DNS server IP address. */
+    ANSC_IPV4_ADDRESS PrimaryDHCPServer;       /**< Primary DHCP server IP address. */
+    ANSC_IPV4_ADDRESS SecondaryDHCPServer;     /**< Secondary DHCP server IP address. */
+    ULONG LeaseTimeRemaining;                  /**< Remaining lease time in seconds. */
+    ULONG RebindTimeRemaining;                 /**< Remaining time to rebind in seconds. */
+    ULONG RenewTimeRemaining;                  /**< Remaining time to renew in seconds. */
+    UCHAR MACAddress[6];                       /**< MAC address of the MTA. */
+    CHAR BootFileName[64];                     /**< Boot file name received from the DHCP server. */
+    CHAR FQDN[64];                             /**< Fully Qualified Domain Name. */
+    CHAR DHCPOption3[64];                      /**< Custom DHCP Option 3. */
+    CHAR DHCPOption6[64];                      /**< Custom DHCP Option 6. */
+    CHAR DHCPOption7[64];                      /**< Custom DHCP Option 7. */
+    CHAR DHCPOption8[64];                      /**< Custom DHCP Option 8. */
+    CHAR PCVersion[64];                        /**< Version of the PC. */
+} MTAMGMT_MTA_DHCP_INFO_BIN, *PMTAMGMT_MTA_DHCP_INFO_BIN;
+
+/**
+ * @brief Structure representing DHCPv6 information for an MTA in binary form.
+ *
+ * Same content as MTAMGMT_MTA_DHCPv6_INFO, with native in6_addr addresses and integer lease timers so that no text parsing is needed.
+ *
+ * @note Ensure that any value specified does not exceed the buffer size limit defined.
+ */
+typedef struct _MTAMGMT_MTA_DHCPv6_INFO_BIN
+{
+    struct in6_addr IPV6Address;               /**< IPv6 Address assigned to the MTA. */
+    struct in6_addr Prefix;                    /**< Network prefix associated with the IPv6 address. */
+    ULONG PrefixLength;                        /**< Length of Prefix in bits. The value ranges from 0 to 128. */
+    struct in6_addr Gateway;                   /**< Default gateway IPv6 address. */
+    struct in6_addr PrimaryDNS;                /**< Primary DNS server IPv6 address. */
+    struct in6_addr SecondaryDNS;              /**< Secondary DNS server IPv6 address. */
+    struct in6_addr PrimaryDHCPv6Server;       /**< Primary DHCPv6 server IPv6 address. */
+    struct in6_addr SecondaryDHCPv6Server;     /**< Secondary DHCPv6 server IPv6 address. */
+    ULONG LeaseTimeRemaining;                  /**< Remaining lease time in seconds. */
+    ULONG RebindTimeRemaining;                 /**< Remaining time to rebind in seconds. */
+    ULONG RenewTimeRemaining;                  /**< Remaining time to renew in seconds. */
+    UCHAR MACAddress[6];                       /**< The telephony IPv6 MAC address for this device. */
+    CHAR BootFileName[64];                     /**< Boot file name received from the DHCPv6 server. */
+    CHAR FQDN[64];                             /**< Fully Qualified Domain Name. */
+    CHAR DHCPOption3[64];                      /**< Custom DHCP Option 3. */
+    CHAR DHCPOption6[64];                      /**< Custom DHCP Option 6. */
+    CHAR DHCPOption7[64];                      /**< Custom DHCP Option 7. */
+    CHAR DHCPOption8[64];                      /**< Custom DHCP Option 8. */
+    CHAR PCVersion[64];                        /**< Version of the PC. */
+} MTAMGMT_MTA_DHCPv6_INFO_BIN, *PMTAMGMT_MTA_DHCPv6_INFO_BIN;
+
 /**
  * @brief Structure representing the service flow for an MTA (Multimedia Terminal Adapter).
  *
@@ -374,7 +438,7 @@ typedef struct _MTAMGMT_MTA_LINETABLE_INFO
     ULONG CAPort;                                 /**< Circuit Assurance (CA) port number. */
     ULONG MWD;                                    /**< Message Waiting Indicator. Indicates the presence of a voicemail or similar message. */
     ULONG CallsNumber;                            /**< Number of calls associated with this line. */
-    PMTAMGMT_MTA_CALLS pCalls;                    /**< Pointer to calls data. */
+    PMTAMGMT_MTA_CALLS pCalls;                    /**< Pointer to CallsNumber call records, or NULL when CallsNumber is 0. Allocated by the HAL with malloc() and owned by the caller. */
     ULONG CallsUpdateTime;                        /**< Timestamp of the last update to calls information. */
     ULONG OverCurrentFault;                       /**< Over-current fault status. 1 = Normal, 2 = Fault. */
 } MTAMGMT_MTA_LINETABLE_INFO, *PMTAMGMT_MTA_LINETABLE_INFO;
@@ -428,6 +492,87 @@ typedef struct _MTAMGMT_MTA_MTALOG_FULL
     CHAR* pDescription;           /**< Pointer to the description of the log entry. Provides detailed information about the event. Example values: "this is a log for matLog1", "this is a log for matLog2". */
 } MTAMGMT_MTA_MTALOG_FULL, *PMTAMGMT_MTA_MTALOG_FULL;
 
+/**
+ * @brief Structure representing a call record with integer timestamps.
+ *
+ * Wraps MTAMGMT_MTA_CALLS so that existing record layouts are unchanged. Timestamps are in milliseconds since the Unix epoch (UTC);
+ * a value of 0 means the time is not known, e.g. EndTimeMs of a call in progress.
+ */
+typedef struct _MTAMGMT_MTA_CALLS_EX
+{
+    uint64_t StartTimeMs;                 /**< Start time of the call, in milliseconds since the epoch. Same instant as Call.CallStartTime. */
+    uint64_t EndTimeMs;                   /**< End time of the call, in milliseconds since the epoch. Same instant as Call.CallEndTime. */
+    MTAMGMT_MTA_CALLS Call;               /**< Call details. */
+} MTAMGMT_MTA_CALLS_EX, *PMTAMGMT_MTA_CALLS_EX;
+
+#define MTA_CALL_FILTER_TIME            0x00000001   /**< Filter on MTAMGMT_MTA_CALL_FILTER.StartTimeMs/EndTimeMs. */
+#define MTA_CALL_FILTER_ORIGINATOR      0x00000002   /**< Filter on MTAMGMT_MTA_CALL_FILTER.Originator. */
+#define MTA_CALL_FILTER_MOS_LQ          0x00000004   /**< Filter on MTAMGMT_MTA_CALL_FILTER.MinMOS_LQ/MaxMOS_LQ. */
+#define MTA_CALL_FILTER_RFACTOR         0x00000008   /**< Filter on MTAMGMT_MTA_CALL_FILTER.MinRFactor/MaxRFactor. */
+#define MTA_CALL_FILTER_PACKET_LOSS     0x00000010   /**< Filter on MTAMGMT_MTA_CALL_FILTER.MinPacketLoss/MaxPacketLoss. */
+
+/**
+ * @brief Structure holding the criteria of a filtered call query.
+ *
+ * Only the criteria selected in Fields are applied; a call matches when it satisfies all of them. Ranges are inclusive.
+ */
+typedef struct _MTAMGMT_MTA_CALL_FILTER
+{
+    ULONG Fields;                         /**< Bitwise OR of MTA_CALL_FILTER_* values selecting the criteria to apply. */
+    uint64_t StartTimeMs;                 /**< Earliest call start time, in milliseconds since the epoch. */
+    uint64_t EndTimeMs;                   /**< Latest call start time, in milliseconds since the epoch. */
+    BOOLEAN Originator;                   /**< Match calls where the local side is (TRUE) or is not (FALSE) the originating side. */
+    ULONG MinMOS_LQ;                      /**< Minimum MOS_LQ. Scale: 10-50. */
+    ULONG MaxMOS_LQ;                      /**< Maximum MOS_LQ. Scale: 10-50. */
+    ULONG MinRFactor;                     /**< Minimum RFactor. */
+    ULONG MaxRFactor;                     /**< Maximum RFactor. */
+    ULONG MinPacketLoss;                  /**< Minimum count of lost packets. */
+    ULONG MaxPacketLoss;                  /**< Maximum count of lost packets. */
+    ULONG MaxResults;                     /**< Maximum number of records to return, 0 for no limit. When more calls match, the most recent ones are returned. */
+} MTAMGMT_MTA_CALL_FILTER, *PMTAMGMT_MTA_CALL_FILTER;
+
+/**
+ * @brief Structure representing a DSX log entry with an integer timestamp.
+ */
+typedef struct _MTAMGMT_MTA_DSXLOG_EX
+{
+    uint64_t TimeMs;                      /**< Time of the log entry, in milliseconds since the epoch. Same instant as Log.Time. */
+    MTAMGMT_MTA_DSXLOG Log;               /**< Log entry. */
+} MTAMGMT_MTA_DSXLOG_EX, *PMTAMGMT_MTA_DSXLOG_EX;
+
+/**
+ * @brief Structure representing an MTA log entry with an integer timestamp.
+ */
+typedef struct _MTAMGMT_MTA_MTALOG_FULL_EX
+{
+    uint64_t TimeMs;                      /**< Time of the log entry, in milliseconds since the epoch. Same instant as Log.Time. */
+    MTAMGMT_MTA_MTALOG_FULL Log;          /**< Log entry. */
+} MTAMGMT_MTA_MTALOG_FULL_EX, *PMTAMGMT_MTA_MTALOG_FULL_EX;
+
+#define MTA_LOG_FILTER_LEVEL            0x00000001   /**< Filter on MTAMGMT_MTA_LOG_FILTER.MaxLevel. */
+#define MTA_LOG_FILTER_EVENT_ID         0x00000002   /**< Filter on MTAMGMT_MTA_LOG_FILTER.pEventIDs. */
+#define MTA_LOG_FILTER_TIME             0x00000004   /**< Filter on MTAMGMT_MTA_LOG_FILTER.StartTimeMs/EndTimeMs. */
+
+/**
+ * @brief Structure holding the criteria of a filtered DSX or MTA log query.
+ *
+ * Log levels follow syslog numbering, 0 being the most severe. Only the criteria selected in Fields are applied;
+ * an entry matches when it satisfies all of them. Ranges are inclusive.
+ *
+ * @note pEventIDs is a pointer, so the structure cannot be copied byte for byte across a process or capture boundary.
+ *       The record and broker shims encode it as described in mta_hal_record.h.
+ */
+typedef struct _MTAMGMT_MTA_LOG_FILTER
+{
+    ULONG Fields;                         /**< Bitwise OR of MTA_LOG_FILTER_* values selecting the criteria to apply. */
+    ULONG MaxLevel;                       /**< Highest level value to include, i.e. the least severe level: entries whose level value is numerically greater are excluded. */
+    const ULONG *pEventIDs;               /**< Caller owned array of EventIDCount event IDs to include, matched against MTAMGMT_MTA_DSXLOG.ID or MTAMGMT_MTA_MTALOG_FULL.EventID. Only read during the call. */
+    ULONG EventIDCount;                   /**< Number of entries in pEventIDs. */
+    uint64_t StartTimeMs;                 /**< Earliest entry time, in milliseconds since the epoch. */
+    uint64_t EndTimeMs;                   /**< Latest entry time, in milliseconds since the epoch. */
+    ULONG MaxResults;                     /**< Maximum number of entries to return, 0 for no limit. When more entries match, the most recent ones are returned. */
+} MTAMGMT_MTA_LOG_FILTER, *PMTAMGMT_MTA_LOG_FILTER;
+
 /**
  * @brief Structure representing battery information for an MTA (Multimedia Terminal Adapter).
  *
@@ -446,6 +591,10 @@ typedef struct _MTAMGMT_MTA_BATTERY_INFO
 } MTAMGMT_MTA_BATTERY_INFO, *PMTAMGMT_MTA_BATTERY_INFO;
 
 
+/*
+ * Compile-time line count for the MTAMGMT_MTA_STATUS array APIs. Devices with more lines report their
+ * actual line count through mta_hal_getLineCount() and use the packed line register status APIs.
+ */
 #define MTA_LINENUMBER 8
 
 /**
@@ -510,6 +659,81 @@ typedef enum{
 */
 INT   mta_hal_InitDB(void);
 
+/**
+ * @brief Represents the initialisation mode of mta_hal_InitDBEx().
+ */
+typedef enum {
+   MTA_INIT_MODE_BLOCKING=0,       /**< Initialise every subsystem before returning, as mta_hal_InitDB() does. */
+   MTA_INIT_MODE_LAZY=1,           /**< Return immediately; each subsystem is initialised on the first call that uses it. */
+   MTA_INIT_MODE_BACKGROUND=2      /**< Return immediately and initialise independent subsystems in parallel in the background. A call that uses a subsystem still initialising waits for it. */
+} MTAMGMT_MTA_INIT_MODE;
+
+/**
+ * @brief Represents the HAL subsystems that are initialised independently.
+ */
+typedef enum {
+   MTA_SUBSYS_DHCP=0,              /**< DHCP and DHCPv6 information. */
+   MTA_SUBSYS_LINE_TABLE=1,        /**< Line table, calls and call processing. */
+   MTA_SUBSYS_DECT=2,              /**< DECT module and handsets. */
+   MTA_SUBSYS_BATTERY=3,           /**< Battery. */
+   MTA_SUBSYS_LOGS=4,              /**< DSX, MTA and CallSignalling logs. */
+   MTA_SUBSYS_MAX=5                /**< Number of subsystems, not a valid subsystem. */
+} MTAMGMT_MTA_SUBSYSTEM;
+
+/**
+ * @brief Represents the initialisation state of a subsystem.
+ */
+typedef enum {
+   MTA_SUBSYS_NOT_STARTED=0,       /**< Initialisation has not started. */
+   MTA_SUBSYS_INITIALISING=1,      /**< Initialisation is in progress. */
+   MTA_SUBSYS_READY=2,             /**< Subsystem is ready for use. */
+   MTA_SUBSYS_FAILED=3             /**< Initialisation failed; it is retried on the next call that uses the subsystem. */
+} MTAMGMT_MTA_SUBSYSTEM_STATE;
+
+/**
+ * @brief Structure representing the initialisation status of a subsystem.
+ */
+typedef struct _MTAMGMT_MTA_SUBSYSTEM_STATUS
+{
+    MTAMGMT_MTA_SUBSYSTEM_STATE State;    /**< Initialisation state. */
+    ULONG InitTimeMs;                     /**< Time taken to initialise, in milliseconds. Time elapsed so far while MTA_SUBSYS_INITIALISING, 0 while MTA_SUBSYS_NOT_STARTED. */
+} MTAMGMT_MTA_SUBSYSTEM_STATUS, *PMTAMGMT_MTA_SUBSYSTEM_STATUS;
+
+/**
+* @brief Initialise the HAL with the given initialisation mode.
+*        mta_hal_InitDBEx(MTA_INIT_MODE_BLOCKING) is equivalent to mta_hal_InitDB().
+* @param[in] Mode - Initialisation mode from MTAMGMT_MTA_INIT_MODE enumeration.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful. With MTA_INIT_MODE_LAZY or MTA_INIT_MODE_BACKGROUND, subsystem failures are reported through mta_hal_GetSubsystemStatus() instead.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT   mta_hal_InitDBEx(MTAMGMT_MTA_INIT_MODE Mode);
+
+/**
+* @brief Initialise a subsystem now, if not already done, e.g. to warm it up ahead of first use.
+* @param[in] Subsystem - Subsystem from MTAMGMT_MTA_SUBSYSTEM enumeration.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if the subsystem is ready.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT   mta_hal_InitSubsystem(MTAMGMT_MTA_SUBSYSTEM Subsystem);
+
+/**
+* @brief Get the initialisation status of a subsystem.
+* @param[in] Subsystem - Subsystem from MTAMGMT_MTA_SUBSYSTEM enumeration.
+* @param[out] pStatus - Structure variable of type PMTAMGMT_MTA_SUBSYSTEM_STATUS containing readiness and time taken, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT   mta_hal_GetSubsystemStatus(MTAMGMT_MTA_SUBSYSTEM Subsystem, PMTAMGMT_MTA_SUBSYSTEM_STATUS pStatus);
+
 /**
 * @brief Retrieve all the relevant DHCP info for MTA.
 * @param[out] pInfo pointer to PMTAMGMT_MTA_DHCP_INFO structure that will hold all DHCP info for MTA, to be returned.
@@ -535,6 +759,29 @@ INT mta_hal_GetDHCPInfo(PMTAMGMT_MTA_DHCP_INFO pInfo);
 
 INT mta_hal_GetDHCPV6Info(PMTAMGMT_MTA_DHCPv6_INFO pInfo);
 
+/**
+* @brief Retrieve all the relevant DHCP info for MTA in binary form.
+* @param[out] pInfo pointer to PMTAMGMT_MTA_DHCP_INFO_BIN structure that will hold all DHCP info for MTA, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetDHCPInfoBin(PMTAMGMT_MTA_DHCP_INFO_BIN pInfo);
+
+/**
+* @brief Retrieve all the relevant DHCPv6 info for MTA in binary form.
+* @param[out] pInfo pointer to PMTAMGMT_MTA_DHCPv6_INFO_BIN structure that will hold all DHCPv6 info for MTA, to be returned.
+*                   Addresses that are not assigned are returned as the unspecified address (::).
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetDHCPV6InfoBin(PMTAMGMT_MTA_DHCPv6_INFO_BIN pInfo);
+
 /**
 * @brief Get the number of entries in the line table.
 *
@@ -551,6 +798,10 @@ ULONG mta_hal_LineTableGetNumberOfEntries(void);
 * @param[in] Index - index to the table entry. The value ranges from 0 to (2^32)-1.
 * @param[out] pEntry - Structure variable containing MTA Line table entry info, to be returned.
 *
+* @note pEntry->pCalls is allocated by the HAL with malloc() as one block of pEntry->CallsNumber records, or set to NULL when there are
+*       none. It is owned by the caller from the successful return, and stays valid until the caller releases it with free().
+*       On failure pEntry->pCalls is not allocated.
+*
 * @return The status of the operation
 * @retval RETURN_OK if successful.
 * @retval RETURN_ERR if any error is detected
@@ -575,6 +826,7 @@ INT   mta_hal_TriggerDiagnostics(ULONG Index);
 * @brief Get all the service flow info
 * @param[out] Count - it is an unsigned long integer that provides the number of service flow entries, to be returned. The value ranges from 0 to (2^32)-1.
 * @param[out] ppCfg - Pointer to structure containing service flow info, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
 *
 * @return The status of the operation.
 * @retval RETURN_OK if successful.
@@ -682,6 +934,8 @@ INT mta_hal_SetDectPIN(char* pPINString);
 * @brief Get MTA handset info
 * @param[in] pulCount  - Unsigned long integer pointer that provides handset number. The value ranges from 0 to (2^32)-1.
 * @param[out] ppHandsets - Pointer to ppHandsets structure that contains Info of MTA handset.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
 * @return The status of the operation.
 * @retval RETURN_OK if successful.
 * @retval RETURN_ERR if any error is detected
@@ -694,6 +948,7 @@ INT mta_hal_GetHandsets(ULONG* pulCount, PMTAMGMT_MTA_HANDSETS_INFO* ppHandsets)
 * @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
 * @param[out] Count - Unsigned long integer pointer that provides number of entries(calls) for the call info array, to be returned. The valid range is 0 to (2^32)-1.
 * @param[out] ppCfg - Array with call info, to be returned
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
 *
 * @return The status of the operation.
 * @retval RETURN_OK if successful.
@@ -702,6 +957,36 @@ INT mta_hal_GetHandsets(ULONG* pulCount, PMTAMGMT_MTA_HANDSETS_INFO* ppHandsets)
 */
 INT   mta_hal_GetCalls(ULONG InstanceNumber, ULONG *Count, PMTAMGMT_MTA_CALLS *ppCfg);
 
+/**
+* @brief Retrieve all call info for the given instance number of LineTable, with integer timestamps.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[out] Count - Unsigned long integer pointer that provides number of entries(calls) for the call info array, to be returned. The valid range is 0 to (2^32)-1.
+* @param[out] ppCfg - Array with call info, ordered by StartTimeMs, oldest first, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT   mta_hal_GetCallsEx(ULONG InstanceNumber, ULONG *Count, PMTAMGMT_MTA_CALLS_EX *ppCfg);
+
+/**
+* @brief Retrieve the calls of the given instance number of LineTable that match a filter.
+*        Filtering is done by the HAL, so only matching records are allocated and copied.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[in] pFilter - Filter criteria. See MTAMGMT_MTA_CALL_FILTER.
+* @param[out] Count - Unsigned long integer pointer that provides number of matching calls in the array, to be returned. Never exceeds pFilter->MaxResults when it is set.
+* @param[out] ppCfg - Array with the matching calls, ordered by StartTimeMs, oldest first, to be returned. NULL when Count is 0.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. pFilter holds an unknown Fields bit.
+*
+*/
+INT   mta_hal_QueryCalls(ULONG InstanceNumber, const MTAMGMT_MTA_CALL_FILTER *pFilter, ULONG *Count, PMTAMGMT_MTA_CALLS_EX *ppCfg);
+
 /**
 * @brief Retrieve the Call processing status information for the line number
 * @param[in]  LineNumber - Unsigned long integer that provides Line number for which to retrieve info on Call processing status.
@@ -720,6 +1005,7 @@ INT   mta_hal_GetCALLP(ULONG LineNumber, PMTAMGMT_MTA_CALLP pCallp);
 * @brief Retrieve all DSX log entries
 * @param[out] Count - Unsigned long integer pointer to store the number of entries in the log. The value ranges from 0 to (2^32)-1.
 * @param[out] ppDSXLog - array of DSX log entries, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
 
 * @return The status of the operation.
 * @retval RETURN_OK if successful.
@@ -728,6 +1014,19 @@ INT   mta_hal_GetCALLP(ULONG LineNumber, PMTAMGMT_MTA_CALLP pCallp);
 */
 INT   mta_hal_GetDSXLogs(ULONG *Count, PMTAMGMT_MTA_DSXLOG *ppDSXLog);
 
+/**
+* @brief Retrieve all DSX log entries with integer timestamps
+* @param[out] Count - Unsigned long integer pointer to store the number of entries in the log. The value ranges from 0 to (2^32)-1.
+* @param[out] ppDSXLog - array of DSX log entries, ordered by TimeMs, oldest first, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT   mta_hal_GetDSXLogsEx(ULONG *Count, PMTAMGMT_MTA_DSXLOG_EX *ppDSXLog);
+
 /**
 * @brief Get DSX log enable status
 * @param[out] pBool - It is a boolean pointer of 1 byte size, pointing to the value of enable, to be returned.
@@ -807,6 +1106,8 @@ INT mta_hal_ClearCallSignallingLog(BOOLEAN Bool) ;
 * @brief Get all log entries from the MTA Log
 * @param[out] Count - Unsigned long integer pointer that provides number of entries in the log, to be returned. The range is 0 to the (2^32)-1.
 * @param[out] ppCfg - array of log entries, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block, and each non-NULL pDescription with a separate malloc().
+*       The caller frees every pDescription, then the array, with free().
 
 * @return The status of the operation.
 * @retval RETURN_OK if successful.
@@ -815,6 +1116,52 @@ INT mta_hal_ClearCallSignallingLog(BOOLEAN Bool) ;
 */
 INT mta_hal_GetMtaLog(ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL *ppCfg);
 
+/**
+* @brief Get all log entries from the MTA Log with integer timestamps
+* @param[out] Count - Unsigned long integer pointer that provides number of entries in the log, to be returned. The range is 0 to the (2^32)-1.
+* @param[out] ppCfg - array of log entries, ordered by TimeMs, oldest first, to be returned.
+* @note The array is allocated by the HAL with malloc() as one block, and each non-NULL pDescription with a separate malloc().
+*       The caller frees every pDescription, then the array, with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetMtaLogEx(ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL_EX *ppCfg);
+
+/**
+* @brief Retrieve the DSX log entries that match a filter.
+*        The HAL keeps a per-level index of the log, so the cost is proportional to the matching entries rather than to the log size.
+* @param[in] pFilter - Filter criteria. See MTAMGMT_MTA_LOG_FILTER.
+* @param[out] Count - Unsigned long integer pointer to store the number of matching entries. The value ranges from 0 to (2^32)-1.
+* @param[out] ppDSXLog - array of matching DSX log entries, ordered by TimeMs, oldest first, to be returned. NULL when Count is 0.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. pFilter holds an unknown Fields bit.
+*
+*/
+INT mta_hal_QueryDSXLogs(const MTAMGMT_MTA_LOG_FILTER *pFilter, ULONG *Count, PMTAMGMT_MTA_DSXLOG_EX *ppDSXLog);
+
+/**
+* @brief Retrieve the MTA log entries that match a filter.
+*        The HAL keeps a per-level index of the log, so the cost is proportional to the matching entries rather than to the log size.
+*        MTAMGMT_MTA_MTALOG_FULL.EventLevel is compared as its numeric value.
+* @param[in] pFilter - Filter criteria. See MTAMGMT_MTA_LOG_FILTER.
+* @param[out] Count - Unsigned long integer pointer that provides number of matching entries, to be returned. The range is 0 to the (2^32)-1.
+* @param[out] ppCfg - array of matching log entries, ordered by TimeMs, oldest first, to be returned. NULL when Count is 0.
+* @note The array is allocated by the HAL with malloc() as one block, and each non-NULL pDescription with a separate malloc().
+*       The caller frees every pDescription, then the array, with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. pFilter holds an unknown Fields bit.
+*
+*/
+INT mta_hal_QueryMtaLog(const MTAMGMT_MTA_LOG_FILTER *pFilter, ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL_EX *ppCfg);
+
 /**
 * @brief Check to see if the battery is installed
 * @param[out] Val - It is a boolean pointer with 1 byte size, which holds the value to be returned.
@@ -994,6 +1341,67 @@ INT mta_hal_Get_LineResetCount(ULONG *resetcnt);
 */
 INT mta_hal_ClearCalls(ULONG InstanceNumber);
 
+/**
+ * @brief Structure holding the retention configuration of the call history of one line.
+ *
+ * The HAL keeps the call history of each line in a store preallocated for MaxEntries records. When the store is full the oldest call
+ * is evicted to make room for a new one, and calls older than MaxAgeSec are evicted as they expire.
+ */
+typedef struct _MTAMGMT_MTA_CALL_HISTORY_CONFIG
+{
+    ULONG MaxEntries;                     /**< Capacity of the store, in call records. Must be at least 1 and not exceed MTAMGMT_MTA_RETENTION_LIMITS.MaxCallsPerLine when that is set. */
+    ULONG MaxAgeSec;                      /**< Maximum age of a retained call, measured from its end time, in seconds. 0 disables age based eviction. */
+} MTAMGMT_MTA_CALL_HISTORY_CONFIG, *PMTAMGMT_MTA_CALL_HISTORY_CONFIG;
+
+/**
+ * @brief Structure representing the occupancy of the call history store of one line.
+ */
+typedef struct _MTAMGMT_MTA_CALL_HISTORY_OCCUPANCY
+{
+    ULONG Entries;                        /**< Number of call records currently retained. */
+    ULONG Capacity;                       /**< Number of call records the store is preallocated for. */
+    ULONG EvictedCount;                   /**< Number of call records evicted since the line was initialised or last cleared. */
+    ULONG ReservedBytes;                  /**< Memory preallocated for the store, in bytes. */
+    uint64_t OldestStartTimeMs;           /**< Start time of the oldest retained call, in milliseconds since the epoch. 0 when the store is empty. */
+} MTAMGMT_MTA_CALL_HISTORY_OCCUPANCY, *PMTAMGMT_MTA_CALL_HISTORY_OCCUPANCY;
+
+/**
+* @brief Get the call history retention configuration of a line.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[out] pConfig - Structure variable of type PMTAMGMT_MTA_CALL_HISTORY_CONFIG containing the configuration, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetCallHistoryConfig(ULONG InstanceNumber, PMTAMGMT_MTA_CALL_HISTORY_CONFIG pConfig);
+
+/**
+* @brief Set the call history retention configuration of a line.
+*        The store is reallocated to the new capacity; when it shrinks, the oldest calls are evicted. The configuration is not persisted.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[in] pConfig - Structure variable of type PMTAMGMT_MTA_CALL_HISTORY_CONFIG containing the configuration to apply.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. MaxEntries is 0 or exceeds the retention limits.
+*
+*/
+INT mta_hal_SetCallHistoryConfig(ULONG InstanceNumber, PMTAMGMT_MTA_CALL_HISTORY_CONFIG pConfig);
+
+/**
+* @brief Get the occupancy of the call history store of a line.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[out] pOccupancy - Structure variable of type PMTAMGMT_MTA_CALL_HISTORY_OCCUPANCY containing the occupancy, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetCallHistoryOccupancy(ULONG InstanceNumber, PMTAMGMT_MTA_CALL_HISTORY_OCCUPANCY pOccupancy);
+
 /**
 * @brief Get the DHCP status for MTA
 * @param[out] output_pIpv4status - ipv4 dhcp status from MTAMGMT_MTA_STATUS enumeration.
@@ -1063,6 +1471,41 @@ INT mta_hal_getMtaOperationalStatus(MTAMGMT_MTA_STATUS *operationalStatus);
 */
 INT mta_hal_getMtaProvisioningStatus(MTAMGMT_MTA_PROVISION_STATUS *provisionStatus);
 
+/**
+ * @brief Structure representing a consistent snapshot of the MTA health indicators.
+ *
+ * All fields are sampled together by the HAL, so they describe the same instant and are obtained with a single call into the vendor software.
+ *
+ * @note Ensure that any value specified does not exceed the buffer size limit defined.
+ */
+typedef struct _MTAMGMT_MTA_HEALTH_SNAPSHOT
+{
+    uint64_t TimeMs;                                        /**< Time the snapshot was taken, in milliseconds since the epoch. */
+    MTAMGMT_MTA_STATUS OperationalStatus;                   /**< As returned by mta_hal_getMtaOperationalStatus(). */
+    MTAMGMT_MTA_PROVISION_STATUS ProvisioningStatus;        /**< As returned by mta_hal_getMtaProvisioningStatus(). */
+    MTAMGMT_MTA_STATUS DhcpIpv4Status;                      /**< IPv4 DHCP status, as returned by mta_hal_getDhcpStatus(). */
+    MTAMGMT_MTA_STATUS DhcpIpv6Status;                      /**< IPv6 DHCP status, as returned by mta_hal_getDhcpStatus(). */
+    MTAMGMT_MTA_STATUS ConfigFileStatus;                    /**< As returned by mta_hal_getConfigFileStatus(). */
+    ULONG MTAResetCount;                                    /**< As returned by mta_hal_Get_MTAResetCount(). */
+    ULONG LineResetCount;                                   /**< As returned by mta_hal_Get_LineResetCount(). */
+    CHAR BatteryPowerStatus[32];                            /**< As returned by mta_hal_BatteryGetPowerStatus(): "AC", "Battery" or "Unknown". */
+    ULONG LineCount;                                        /**< Number of lines on the device, as returned by mta_hal_getLineCount(). */
+    MTAMGMT_MTA_STATUS LineRegisterStatus[MTA_LINENUMBER];  /**< Register status of the first MTA_LINENUMBER lines. Use mta_hal_getLineRegisterStatusPacked() when LineCount exceeds MTA_LINENUMBER. */
+} MTAMGMT_MTA_HEALTH_SNAPSHOT, *PMTAMGMT_MTA_HEALTH_SNAPSHOT;
+
+/**
+* @brief Get a consistent snapshot of the MTA health indicators in one call.
+*        Replaces separate calls to the operational, provisioning, DHCP, config file and line register status getters, the reset counters
+*        and mta_hal_BatteryGetPowerStatus().
+* @param[out] pSnapshot - Structure variable of type PMTAMGMT_MTA_HEALTH_SNAPSHOT containing the health indicators, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetHealthSnapshot(PMTAMGMT_MTA_HEALTH_SNAPSHOT pSnapshot);
+
 #define MTA_DHCPOPTION122SUBOPTION1_MAX          4
 #define MTA_DHCPOPTION122SUBOPTION2_MAX          4
 #define MTA_DHCPOPTION122CCCV6DSSID1_MAX         32
@@ -1112,6 +1555,62 @@ MTAMGMT_PROVISIONING_PARAMS, *PMTAMGMT_MTA_PROVISIONING_PARAMS;
 */
 INT mta_hal_start_provisioning(PMTAMGMT_MTA_PROVISIONING_PARAMS pParameters);
 
+#define MTA_PROV_FLAG_WARM_START        0x00000001   /**< Bring lines into service from the warm-start record, if valid, and re-validate in the background. */
+
+/**
+ * @brief Structure representing the warm-start provisioning record kept on flash by the HAL.
+ *
+ * The record holds the last provisioning result that was fully validated: the DHCP lease, the hash of the accepted config file and
+ * the line registrations. It is only used when the provisioning parameters match the ones it was saved with.
+ */
+typedef struct _MTAMGMT_MTA_WARM_START_INFO
+{
+    BOOLEAN Valid;                        /**< TRUE if a usable record is present. */
+    BOOLEAN Used;                         /**< TRUE if the current provisioning was brought up from the record. */
+    uint64_t SavedTimeMs;                 /**< Time the record was saved, in milliseconds since the epoch. */
+    ULONG LeaseTimeRemaining;             /**< Remaining lease time of the recorded lease at SavedTimeMs, in seconds. */
+    UCHAR ConfigFileHash[32];             /**< SHA-256 hash of the recorded config file. */
+    ULONG LineCount;                      /**< Number of lines with a recorded registration. */
+    MTAMGMT_MTA_STATUS Revalidation;      /**< Background re-validation state: MTA_INIT if not needed, MTA_START while running, MTA_COMPLETE, or MTA_ERROR/MTA_REJECTED if the full sequence did not confirm the record. */
+} MTAMGMT_MTA_WARM_START_INFO, *PMTAMGMT_MTA_WARM_START_INFO;
+
+/**
+* @brief Start IP provisioning for all the lines, with options.
+*        mta_hal_start_provisioning_ex(pParameters, 0) is equivalent to mta_hal_start_provisioning(pParameters).
+*        With MTA_PROV_FLAG_WARM_START, if a valid warm-start record matching pParameters exists and its lease has not expired, the lines are
+*        brought into service from it and the full DHCP option 122 / option 2171 and config file sequence runs in the background. If re-validation
+*        yields a different result, the lines are re-provisioned with it and the record is replaced. Otherwise a full provisioning is performed.
+* @param[in] pParameters - IP provisioning parameters from PMTAMGMT_MTA_PROVISIONING_PARAMS structure.
+* @param[in] Flags - Bitwise OR of MTA_PROV_FLAG_* values.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_start_provisioning_ex(PMTAMGMT_MTA_PROVISIONING_PARAMS pParameters, ULONG Flags);
+
+/**
+* @brief Get information on the warm-start provisioning record.
+* @param[out] pInfo - Structure variable of type PMTAMGMT_MTA_WARM_START_INFO containing the record information, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetWarmStartInfo(PMTAMGMT_MTA_WARM_START_INFO pInfo);
+
+/**
+* @brief Erase the warm-start provisioning record, so the next provisioning runs the full sequence.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_ClearWarmStartInfo(void);
+
 /**
 * @brief Callback function type for getting MTA line register status.
 *        This callback function is used to obtain the status of line registration.
@@ -1134,6 +1633,625 @@ typedef INT ( * mta_hal_getLineRegisterStatus_callback)(MTAMGMT_MTA_STATUS *outp
 
 void mta_hal_LineRegisterStatus_callback_register(mta_hal_getLineRegisterStatus_callback callback_proc); //Callback registration function.
 
+/**
+* @brief Callback function type for line register status subscribers.
+* @param output_status_array - array buffer for all line register status data from MTAMGMT_MTA_STATUS enumeration. Owned by the HAL and only valid for the duration of the callback.
+* @param array_size - It is a 4 byte integer that provides buffer size (total line number).
+* @param pUserData - Opaque pointer passed to mta_hal_LineRegisterStatus_subscribe().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+typedef INT ( * mta_hal_LineRegisterStatus_subscriber)(MTAMGMT_MTA_STATUS *output_status_array, int array_size, void *pUserData);
+
+/**
+* @brief Add a subscriber for line register status updates.
+*        Unlike mta_hal_LineRegisterStatus_callback_register(), any number of subscribers may be added and none replaces another.
+*        Each subscriber has its own bounded queue and its own delivery thread, so the vendor stack only enqueues and never waits on a subscriber,
+*        and a slow subscriber does not delay the others. When a subscriber's queue is full, pending updates are coalesced so that the
+*        subscriber always receives the latest status.
+* @param[in] callback_proc - Subscriber callback. Must not be NULL.
+* @param[in] pUserData - Opaque pointer handed back to callback_proc.
+* @param[in] QueueDepth - Number of updates that may be pending for this subscriber before coalescing starts. 0 selects the HAL default.
+* @param[out] pSubscriptionId - Identifier of the subscription, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_LineRegisterStatus_subscribe(mta_hal_LineRegisterStatus_subscriber callback_proc, void *pUserData, ULONG QueueDepth, ULONG *pSubscriptionId);
+
+/**
+* @brief Remove a line register status subscriber.
+*        Pending updates are discarded. When the function returns, the callback is not running and will not be called again,
+*        unless it is called from within the callback itself.
+* @param[in] SubscriptionId - Identifier returned by mta_hal_LineRegisterStatus_subscribe().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the subscription is unknown.
+*
+*/
+INT mta_hal_LineRegisterStatus_unsubscribe(ULONG SubscriptionId);
+
+#define MTA_EVENT_LINE_REGISTER_STATUS  0x00000001   /**< Line register status changed, see mta_hal_getLineRegisterStatus(). */
+#define MTA_EVENT_PROVISIONING_STATUS   0x00000002   /**< Provisioning or operational status changed, see mta_hal_getMtaProvisioningStatus() and mta_hal_getMtaOperationalStatus(). */
+#define MTA_EVENT_DHCP_STATUS           0x00000004   /**< DHCP or DHCPv6 state changed, see mta_hal_getDhcpStatus(). */
+#define MTA_EVENT_CONFIG_FILE_STATUS    0x00000008   /**< Config file status changed, see mta_hal_getConfigFileStatus(). */
+#define MTA_EVENT_CALL_QUALITY_ALARM    0x00000010   /**< Call quality alarms are pending, see mta_hal_GetCallQualityAlarms(). */
+
+/**
+* @brief Open a notification file descriptor for MTA state changes.
+*        The descriptor becomes readable (POLLIN/EPOLLIN) when any of the selected events has occurred since the last mta_hal_DrainEvents(),
+*        and can be added to a poll/epoll event loop. Events are coalesced: several changes of the same kind are reported once.
+*        The caller must not read from or write to the descriptor directly.
+* @param[in] EventMask - Bitwise OR of MTA_EVENT_* values selecting the events to report.
+* @param[out] pFd - Notification file descriptor, to be returned. It is non-blocking and close-on-exec.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_OpenEventFd(ULONG EventMask, INT *pFd);
+
+/**
+* @brief Collect the pending events of a notification file descriptor without blocking.
+*        Clears the pending events, so the descriptor is no longer readable until a new event occurs.
+*        The caller then queries the current state with the corresponding getters.
+* @param[in] Fd - Descriptor returned by mta_hal_OpenEventFd().
+* @param[out] pEventMask - Bitwise OR of the MTA_EVENT_* values that occurred, to be returned. 0 if no event is pending.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. Fd was not returned by mta_hal_OpenEventFd().
+*
+*/
+INT mta_hal_DrainEvents(INT Fd, ULONG *pEventMask);
+
+/**
+* @brief Close a notification file descriptor and release its resources.
+* @param[in] Fd - Descriptor returned by mta_hal_OpenEventFd(). It must be removed from any event loop before closing.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_CloseEventFd(INT Fd);
+
+/**
+ * @brief Represents the call quality metric an alarm threshold applies to.
+ */
+typedef enum {
+   MTA_ALARM_MOS_LQ=0,             /**< MOS_LQ, scale 10-50. Alarm is raised when the value falls below the threshold. */
+   MTA_ALARM_RFACTOR=1,            /**< RFactor. Alarm is raised when the value falls below the threshold. */
+   MTA_ALARM_PACKET_LOSS=2,        /**< PacketLoss, count of lost packets. Alarm is raised when the value rises above the threshold. */
+   MTA_ALARM_ROUND_TRIP_DELAY=3,   /**< RoundTripDelay, in milliseconds. Alarm is raised when the value rises above the threshold. */
+   MTA_ALARM_INTERVAL_JITTER=4,    /**< IntervalJitter, in milliseconds. Alarm is raised when the value rises above the threshold. */
+   MTA_ALARM_METRIC_MAX=5          /**< Number of metrics, not a valid metric. */
+} MTAMGMT_MTA_ALARM_METRIC;
+
+/**
+ * @brief Structure holding the alarm threshold of one call quality metric.
+ *
+ * Hysteresis is provided by separate raise and clear thresholds: an alarm raised when the value crosses RaiseThreshold is only cleared
+ * once the value has crossed back past ClearThreshold. ClearThreshold must lie on the good side of RaiseThreshold.
+ */
+typedef struct _MTAMGMT_MTA_ALARM_THRESHOLD
+{
+    BOOLEAN Enable;                       /**< TRUE to evaluate this metric. */
+    ULONG RaiseThreshold;                 /**< Value at which the alarm is raised. */
+    ULONG ClearThreshold;                 /**< Value at which a raised alarm is cleared. */
+} MTAMGMT_MTA_ALARM_THRESHOLD, *PMTAMGMT_MTA_ALARM_THRESHOLD;
+
+/**
+ * @brief Structure representing a call quality alarm event.
+ */
+typedef struct _MTAMGMT_MTA_CALL_QUALITY_ALARM
+{
+    ULONG InstanceNumber;                 /**< LineTable instance number of the line the call is on. */
+    MTAMGMT_MTA_ALARM_METRIC Metric;      /**< Metric that crossed its threshold. */
+    BOOLEAN Raised;                       /**< TRUE when the alarm was raised, FALSE when it was cleared. */
+    ULONG Value;                          /**< Value of the metric that triggered the event. */
+    ULONG Threshold;                      /**< Threshold that was crossed. */
+    uint64_t CallStartTimeMs;             /**< Start time of the call, in milliseconds since the epoch, matching MTAMGMT_MTA_CALLS_EX.StartTimeMs. */
+    uint64_t TimeMs;                      /**< Time of the event, in milliseconds since the epoch. */
+} MTAMGMT_MTA_CALL_QUALITY_ALARM, *PMTAMGMT_MTA_CALL_QUALITY_ALARM;
+
+/**
+* @brief Get the call quality alarm thresholds of a line.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[out] pThresholds - Caller allocated array of Count entries, indexed by MTAMGMT_MTA_ALARM_METRIC, to be filled in.
+*                           Entries of metrics the HAL does not support are returned with Enable set to FALSE.
+* @param[in] Count - Number of entries in pThresholds. A caller built against fewer metrics passes a smaller value and only those entries are written.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetCallQualityThresholds(ULONG InstanceNumber, PMTAMGMT_MTA_ALARM_THRESHOLD pThresholds, ULONG Count);
+
+/**
+* @brief Set the call quality alarm thresholds of a line.
+*        The HAL evaluates the thresholds each time it produces or updates a call record on the line and only reports threshold crossings,
+*        to the subscribers added with mta_hal_CallQualityAlarm_subscribe() and through MTA_EVENT_CALL_QUALITY_ALARM. The thresholds are not persisted.
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[in] pThresholds - Array of Count entries, indexed by MTAMGMT_MTA_ALARM_METRIC.
+* @param[in] Count - Number of entries in pThresholds. Thresholds of metrics at or beyond Count are left unchanged.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. a ClearThreshold lies on the bad side of its RaiseThreshold, or a metric the HAL does not support is enabled.
+*
+*/
+INT mta_hal_SetCallQualityThresholds(ULONG InstanceNumber, PMTAMGMT_MTA_ALARM_THRESHOLD pThresholds, ULONG Count);
+
+/**
+* @brief Callback function type for call quality alarm subscribers.
+* @param pAlarm - Alarm event. Owned by the HAL and only valid for the duration of the callback.
+* @param pUserData - Opaque pointer passed to mta_hal_CallQualityAlarm_subscribe().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+typedef INT ( * mta_hal_CallQualityAlarm_subscriber)(PMTAMGMT_MTA_CALL_QUALITY_ALARM pAlarm, void *pUserData);
+
+/**
+* @brief Add a subscriber for call quality alarm events.
+*        Any number of subscribers may be added and none replaces another. As with mta_hal_LineRegisterStatus_subscribe(), each subscriber
+*        has its own bounded queue and its own delivery thread. When a subscriber's queue is full, pending events are coalesced so that the
+*        subscriber receives the latest event of each line and metric.
+* @param[in] callback_proc - Subscriber callback. Must not be NULL.
+* @param[in] pUserData - Opaque pointer handed back to callback_proc.
+* @param[in] QueueDepth - Number of events that may be pending for this subscriber before coalescing starts. 0 selects the HAL default.
+* @param[out] pSubscriptionId - Identifier of the subscription, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_CallQualityAlarm_subscribe(mta_hal_CallQualityAlarm_subscriber callback_proc, void *pUserData, ULONG QueueDepth, ULONG *pSubscriptionId);
+
+/**
+* @brief Remove a call quality alarm subscriber.
+*        Pending events are discarded. When the function returns, the callback is not running and will not be called again,
+*        unless it is called from within the callback itself.
+* @param[in] SubscriptionId - Identifier returned by mta_hal_CallQualityAlarm_subscribe().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the subscription is unknown.
+*
+*/
+INT mta_hal_CallQualityAlarm_unsubscribe(ULONG SubscriptionId);
+
+/**
+* @brief Retrieve and clear the pending call quality alarm events, for clients using mta_hal_OpenEventFd() instead of a subscriber.
+* @param[out] Count - Unsigned long integer pointer that provides number of alarm events in the array, to be returned.
+* @param[out] ppAlarms - Array of alarm events, oldest first, to be returned. NULL when Count is 0.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetCallQualityAlarms(ULONG *Count, PMTAMGMT_MTA_CALL_QUALITY_ALARM *ppAlarms);
+
+/**
+ * @brief Represents the result of a single GR909 diagnostic test.
+ *
+ * This enumeration replaces the free-form result strings of MTAMGMT_MTA_LINETABLE_INFO for the asynchronous diagnostics API.
+ */
+typedef enum {
+   MTA_DIAG_NOT_STARTED=0,      /**< Test has not been started */
+   MTA_DIAG_IN_PROGRESS=1,      /**< Test is running */
+   MTA_DIAG_PASSED=2,           /**< Test passed */
+   MTA_DIAG_FAILED=3,           /**< Test failed */
+   MTA_DIAG_ABORTED=4,          /**< Test was cancelled or interrupted, e.g. by the line going off-hook */
+   MTA_DIAG_NOT_SUPPORTED=5     /**< Test is not supported by the hardware */
+} MTAMGMT_MTA_DIAG_RESULT;
+
+/**
+ * @brief Structure representing the GR909 diagnostic results of one line.
+ *
+ * Filled in by the HAL and delivered through mta_hal_diagnostics_callback once all lines of a request have completed.
+ */
+typedef struct _MTAMGMT_MTA_LINE_DIAG_RESULT
+{
+    ULONG Index;                                        /**< Line table index the results belong to, as passed in pIndexes to mta_hal_TriggerDiagnosticsAsync(). */
+    ULONG LineNumber;                                   /**< MTAMGMT_MTA_LINETABLE_INFO.LineNumber of that line table entry, for information. */
+    INT Status;                                         /**< RETURN_OK if the test sequence ran on this line, RETURN_ERR otherwise. */
+    MTAMGMT_MTA_DIAG_RESULT HazardousPotential;         /**< Result of the HEMF (High Electric and Magnetic Fields) test. */
+    MTAMGMT_MTA_DIAG_RESULT ForeignEMF;                 /**< Result of the FEMF (Foreign Electromagnetic Fields) test. */
+    MTAMGMT_MTA_DIAG_RESULT ResistiveFaults;            /**< Result of the resistive faults test. */
+    MTAMGMT_MTA_DIAG_RESULT ReceiverOffHook;            /**< Result of the receiver off-hook test. */
+    ULONG RingerEquivalency;                            /**< Measured ringer equivalency number in units of 0.01 REN. */
+    ULONG DurationMs;                                   /**< Time taken by the test sequence on this line, in milliseconds. */
+} MTAMGMT_MTA_LINE_DIAG_RESULT, *PMTAMGMT_MTA_LINE_DIAG_RESULT;
+
+/**
+* @brief Callback function type for asynchronous GR909 diagnostics completion.
+*        Called once per request from a HAL owned thread when every requested line has completed or was aborted.
+* @param RequestId - Identifier returned by mta_hal_TriggerDiagnosticsAsync().
+* @param pResults - Array of per-line results, in the order of the requested indexes. Owned by the HAL and only valid for the duration of the callback.
+* @param Count - Number of entries in pResults.
+* @param pUserData - Opaque pointer passed to mta_hal_TriggerDiagnosticsAsync().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+typedef INT ( * mta_hal_diagnostics_callback)(ULONG RequestId, PMTAMGMT_MTA_LINE_DIAG_RESULT pResults, ULONG Count, void *pUserData);
+
+/**
+* @brief Get the number of lines on which GR909 diagnostics can run at the same time.
+* @param[out] pMaxConcurrent - Unsigned long integer pointer that holds the maximum number of concurrently tested lines, to be returned. A value of 1 means tests are serialised.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetDiagnosticsConcurrency(ULONG *pMaxConcurrent);
+
+/**
+* @brief Trigger GR909 diagnostics on a set of lines without blocking.
+*        The HAL runs the tests on as many lines concurrently as reported by mta_hal_GetDiagnosticsConcurrency() and queues the rest.
+*        Results are also reflected in MTAMGMT_MTA_LINETABLE_INFO as with mta_hal_TriggerDiagnostics().
+* @param[in] pIndexes - Array of line table indexes to test, as accepted by mta_hal_LineTableGetEntry() and mta_hal_TriggerDiagnostics().
+*                       These are not MTAMGMT_MTA_LINETABLE_INFO.LineNumber values. The array is copied before the function returns.
+* @param[in] Count - Number of entries in pIndexes. The value ranges from 1 to mta_hal_LineTableGetNumberOfEntries().
+* @param[in] callback_proc - Completion callback. Must not be NULL.
+* @param[in] pUserData - Opaque pointer handed back to callback_proc.
+* @param[out] pRequestId - Identifier of the started request, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if the request was accepted.
+* @retval RETURN_ERR if any error is detected, e.g. an index is invalid or its line is already under test. The callback is not called in this case.
+*
+*/
+INT mta_hal_TriggerDiagnosticsAsync(const ULONG *pIndexes, ULONG Count, mta_hal_diagnostics_callback callback_proc, void *pUserData, ULONG *pRequestId);
+
+/**
+* @brief Cancel a pending asynchronous GR909 diagnostics request.
+*        Lines not yet completed are reported as MTA_DIAG_ABORTED through the completion callback.
+* @param[in] RequestId - Identifier returned by mta_hal_TriggerDiagnosticsAsync().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the request is unknown or has already completed.
+*
+*/
+INT mta_hal_CancelDiagnostics(ULONG RequestId);
+
+/**
+ * @brief Number of bits used to encode one MTAMGMT_MTA_STATUS value in a packed line register status buffer.
+ */
+#define MTA_LINE_STATUS_PACKED_BITS              4
+
+/**
+ * @brief Size in bytes of a packed line register status buffer for the given number of lines.
+ */
+#define MTA_LINE_STATUS_PACKED_SIZE(lines)       (((lines) + 1) / 2)
+
+/**
+ * @brief Size in bytes of a changed-lines bit mask for the given number of lines.
+ */
+#define MTA_LINE_MASK_SIZE(lines)                (((lines) + 7) / 8)
+
+/**
+ * @brief Extract the MTAMGMT_MTA_STATUS of a line, identified by its line table index, from a packed line register status buffer.
+ *        Line n is held in the low nibble of byte n/2 when n is even and in the high nibble when n is odd.
+ */
+#define MTA_LINE_STATUS_PACKED_GET(pPacked, line) \
+        ((MTAMGMT_MTA_STATUS)(((pPacked)[(line) >> 1] >> (((line) & 1) << 2)) & 0x0F))
+
+/**
+ * @brief Test whether a line, identified by its line table index, is set in a changed-lines bit mask. Line n is bit (n % 8) of byte n/8.
+ */
+#define MTA_LINE_MASK_TEST(pMask, line)          (((pMask)[(line) >> 3] >> ((line) & 7)) & 1)
+
+/**
+* @brief Get the number of voice lines supported by the device.
+*        Unlike MTA_LINENUMBER, this value is discovered at runtime and may exceed 8.
+*        The line table has exactly one entry per line, so the value must equal mta_hal_LineTableGetNumberOfEntries(), and line n of the
+*        packed line register status APIs is line table index n. This call exists because mta_hal_LineTableGetNumberOfEntries() has no
+*        way to report a failure distinct from a count.
+* @param[out] pLineCount - Unsigned long integer pointer that holds the number of lines, to be returned. The range is 0 to the (2^32)-1.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_getLineCount(ULONG *pLineCount);
+
+/**
+* @brief Get the register status for all lines in packed form.
+*        Each line is encoded as a MTAMGMT_MTA_STATUS value in MTA_LINE_STATUS_PACKED_BITS bits, see MTA_LINE_STATUS_PACKED_GET().
+* @param[out] pPacked - Caller allocated buffer of at least MTA_LINE_STATUS_PACKED_SIZE(line count) bytes, to be filled in.
+* @param[in] size - Size of pPacked in bytes.
+* @param[out] pLineCount - Number of lines encoded in pPacked, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. size is too small for the line count.
+*
+*/
+INT mta_hal_getLineRegisterStatusPacked(UCHAR *pPacked, ULONG size, ULONG *pLineCount);
+
+/**
+* @brief Callback function type for packed line register status updates.
+*        A single invocation carries the status of every line, so a burst of registration changes across many lines is delivered as one update.
+* @param pPacked - Packed status of all lines, see MTA_LINE_STATUS_PACKED_GET(). Owned by the HAL and only valid for the duration of the callback.
+* @param pChangedMask - Bit mask of the lines whose status changed since the previous invocation, see MTA_LINE_MASK_TEST(). Owned by the HAL.
+* @param lineCount - Number of lines encoded in pPacked and pChangedMask.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+typedef INT ( * mta_hal_LineRegisterStatusPacked_callback)(const UCHAR *pPacked, const UCHAR *pChangedMask, ULONG lineCount);
+
+/**
+* @brief Register a callback function for packed line register status updates.
+*        The HAL may coalesce several changes into one invocation; pChangedMask then holds the union of the changed lines.
+* @param[in] callback_proc - Callback function, or NULL to unregister.
+*
+*/
+void mta_hal_LineRegisterStatusPacked_callback_register(mta_hal_LineRegisterStatusPacked_callback callback_proc);
+
+/*
+ * Deadline-aware variants of the data retrieval APIs.
+ * Each call returns RETURN_TIMEOUT if the data could not be obtained within TimeoutMs milliseconds. On RETURN_TIMEOUT
+ * no output is written and no memory is allocated; the HAL must not touch the caller's buffers after returning,
+ * so that the caller can fall back to cached values. A TimeoutMs of 0 polls without waiting.
+ */
+
+/**
+* @brief Retrieve all the relevant DHCP info for MTA within a time budget. See mta_hal_GetDHCPInfo().
+* @param[out] pInfo pointer to PMTAMGMT_MTA_DHCP_INFO structure that will hold all DHCP info for MTA, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetDHCPInfoWithTimeout(PMTAMGMT_MTA_DHCP_INFO pInfo, ULONG TimeoutMs);
+
+/**
+* @brief Retrieve all the relevant DHCPv6 info for MTA within a time budget. See mta_hal_GetDHCPV6Info().
+* @param[out] pInfo pointer to PMTAMGMT_MTA_DHCPv6_INFO that will hold all DHCPv6 info for MTA, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetDHCPV6InfoWithTimeout(PMTAMGMT_MTA_DHCPv6_INFO pInfo, ULONG TimeoutMs);
+
+/**
+* @brief Get an entry of the line table at the given index within a time budget. See mta_hal_LineTableGetEntry().
+* @param[in] Index - index to the table entry. The value ranges from 0 to (2^32)-1.
+* @param[out] pEntry - Structure variable containing MTA Line table entry info, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_LineTableGetEntryWithTimeout(ULONG Index, PMTAMGMT_MTA_LINETABLE_INFO pEntry, ULONG TimeoutMs);
+
+/**
+* @brief Get all the service flow info within a time budget. See mta_hal_GetServiceFlow().
+* @param[out] Count - Number of service flow entries, to be returned.
+* @param[out] ppCfg - Pointer to structure containing service flow info, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetServiceFlowWithTimeout(ULONG* Count, PMTAMGMT_MTA_SERVICE_FLOW *ppCfg, ULONG TimeoutMs);
+
+/**
+* @brief Get MTA handset info within a time budget. See mta_hal_GetHandsets().
+* @param[out] pulCount - Number of handsets, to be returned.
+* @param[out] ppHandsets - Pointer to ppHandsets structure that contains Info of MTA handset.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetHandsetsWithTimeout(ULONG* pulCount, PMTAMGMT_MTA_HANDSETS_INFO* ppHandsets, ULONG TimeoutMs);
+
+/**
+* @brief Retrieve all call info for the given instance number of LineTable within a time budget. See mta_hal_GetCalls().
+* @param[in] InstanceNumber - Unsigned long integer that provides LineTable's instance number. The valid range is 0 to (2^32)-1.
+* @param[out] Count - Number of entries(calls) for the call info array, to be returned.
+* @param[out] ppCfg - Array with call info, to be returned
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetCallsWithTimeout(ULONG InstanceNumber, ULONG *Count, PMTAMGMT_MTA_CALLS *ppCfg, ULONG TimeoutMs);
+
+/**
+* @brief Retrieve the Call processing status information for the line number within a time budget. See mta_hal_GetCALLP().
+* @param[in]  LineNumber - Line number for which to retrieve info on Call processing status.
+* @param[out]  pCallp - Call processing information, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetCALLPWithTimeout(ULONG LineNumber, PMTAMGMT_MTA_CALLP pCallp, ULONG TimeoutMs);
+
+/**
+* @brief Retrieve all DSX log entries within a time budget. See mta_hal_GetDSXLogs().
+* @param[out] Count - Number of entries in the log, to be returned.
+* @param[out] ppDSXLog - array of DSX log entries, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+* @note The array is allocated by the HAL with malloc() as one block and is released by the caller with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetDSXLogsWithTimeout(ULONG *Count, PMTAMGMT_MTA_DSXLOG *ppDSXLog, ULONG TimeoutMs);
+
+/**
+* @brief Get all log entries from the MTA Log within a time budget. See mta_hal_GetMtaLog().
+* @param[out] Count - Number of entries in the log, to be returned.
+* @param[out] ppCfg - array of log entries, to be returned.
+* @param[in] TimeoutMs - Maximum time to wait for the data, in milliseconds. The value ranges from 0 to (2^32)-1.
+* @note The array is allocated by the HAL with malloc() as one block, and each non-NULL pDescription with a separate malloc().
+*       The caller frees every pDescription, then the array, with free().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+* @retval RETURN_TIMEOUT if the data was not available within TimeoutMs.
+*
+*/
+INT mta_hal_GetMtaLogWithTimeout(ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL *ppCfg, ULONG TimeoutMs);
+
+/**
+ * @brief Structure representing the live memory use of the HAL, per subsystem.
+ *
+ * Byte counts cover heap memory held by the HAL and the underlying vendor software on behalf of the subsystem,
+ * including retained history. Memory handed to the caller by the array APIs is excluded once returned.
+ */
+typedef struct _MTAMGMT_MTA_MEMORY_USAGE
+{
+    ULONG CallsBytes;                  /**< Memory used by retained call records and VQM statistics, in bytes. */
+    ULONG LogsBytes;                   /**< Memory used by DSX, MTA and CallSignalling logs, in bytes. */
+    ULONG FlowsBytes;                  /**< Memory used by service flow information, in bytes. */
+    ULONG HandsetsBytes;               /**< Memory used by DECT and handset information, in bytes. */
+    ULONG OtherBytes;                  /**< Memory used by anything not listed above, in bytes. */
+    ULONG TotalBytes;                  /**< Sum of all the above, in bytes. */
+    ULONG PeakTotalBytes;              /**< Highest TotalBytes observed since mta_hal_InitDB(), in bytes. */
+    ULONG AllocationCount;             /**< Number of live heap allocations held by the HAL. */
+} MTAMGMT_MTA_MEMORY_USAGE, *PMTAMGMT_MTA_MEMORY_USAGE;
+
+#ifndef MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE
+#define MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE       100       /**< Default MTAMGMT_MTA_RETENTION_LIMITS.MaxCallsPerLine after mta_hal_InitDB(). */
+#endif
+
+#ifndef MTA_HAL_DEFAULT_MAX_DSXLOG_ENTRIES
+#define MTA_HAL_DEFAULT_MAX_DSXLOG_ENTRIES       512       /**< Default MTAMGMT_MTA_RETENTION_LIMITS.MaxDSXLogEntries after mta_hal_InitDB(). */
+#endif
+
+#ifndef MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES
+#define MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES       512       /**< Default MTAMGMT_MTA_RETENTION_LIMITS.MaxMtaLogEntries after mta_hal_InitDB(). */
+#endif
+
+#ifndef MTA_HAL_MEMORY_BUDGET_BASE_BYTES
+#define MTA_HAL_MEMORY_BUDGET_BASE_BYTES         1048576   /**< Part of the footprint budget independent of the line count, 1024 KB, covering logs, service flows, handsets and other state. */
+#endif
+
+#ifndef MTA_HAL_MEMORY_BUDGET_PER_LINE_BYTES
+#define MTA_HAL_MEMORY_BUDGET_PER_LINE_BYTES     131072    /**< Part of the footprint budget added per line, 128 KB, covering MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE call records and their VQM statistics. */
+#endif
+
+/**
+ * @brief Footprint budget of the HAL for a given number of lines, in bytes.
+ *
+ * The default MTAMGMT_MTA_RETENTION_LIMITS.MaxTotalBytes after mta_hal_InitDB() is
+ * MTA_HAL_MEMORY_BUDGET(mta_hal_LineTableGetNumberOfEntries()).
+ */
+#define MTA_HAL_MEMORY_BUDGET(lines)             (MTA_HAL_MEMORY_BUDGET_BASE_BYTES + (ULONG)(lines) * MTA_HAL_MEMORY_BUDGET_PER_LINE_BYTES)
+
+#ifndef MTA_HAL_MEMORY_BUDGET_BYTES
+#define MTA_HAL_MEMORY_BUDGET_BYTES              MTA_HAL_MEMORY_BUDGET(MTA_LINENUMBER)   /**< Footprint budget of the HAL with MTA_LINENUMBER lines, 2048 KB. */
+#endif
+
+/**
+ * @brief Structure holding the caps on history retained by the HAL.
+ *
+ * A value of 0 means no HAL-imposed cap for that field. When a cap is reached the oldest entries are discarded first.
+ * After mta_hal_InitDB() the caps hold the MTA_HAL_DEFAULT_* values and MTA_HAL_MEMORY_BUDGET() of the line count.
+ *
+ * MaxTotalBytes takes precedence over the count caps: when retaining history up to the count caps would exceed a non-zero
+ * MaxTotalBytes, the oldest call records and log entries are discarded first, whichever store they belong to, even though
+ * their count caps have not been reached.
+ */
+typedef struct _MTAMGMT_MTA_RETENTION_LIMITS
+{
+    ULONG MaxCallsPerLine;             /**< Maximum number of call records retained per line. */
+    ULONG MaxDSXLogEntries;            /**< Maximum number of DSX log entries retained. */
+    ULONG MaxMtaLogEntries;            /**< Maximum number of MTA log entries retained. */
+    ULONG MaxTotalBytes;               /**< Declared memory budget for the HAL, in bytes. Retained history is trimmed to stay within it. */
+} MTAMGMT_MTA_RETENTION_LIMITS, *PMTAMGMT_MTA_RETENTION_LIMITS;
+
+/**
+* @brief Get the live memory use of the HAL.
+* @param[out] pUsage - Structure variable of type PMTAMGMT_MTA_MEMORY_USAGE containing memory use per subsystem, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetMemoryUsage(PMTAMGMT_MTA_MEMORY_USAGE pUsage);
+
+/**
+* @brief Get the caps on history retained by the HAL.
+* @param[out] pLimits - Structure variable of type PMTAMGMT_MTA_RETENTION_LIMITS containing the active caps, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_GetRetentionLimits(PMTAMGMT_MTA_RETENTION_LIMITS pLimits);
+
+/**
+* @brief Set the caps on history retained by the HAL.
+*        Lowering a cap trims existing history immediately. The caps are not persisted.
+* @param[in] pLimits - Structure variable of type PMTAMGMT_MTA_RETENTION_LIMITS containing the caps to apply.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. MaxTotalBytes is below the minimum the HAL needs to operate.
+*
+*/
+INT mta_hal_SetRetentionLimits(PMTAMGMT_MTA_RETENTION_LIMITS pLimits);
+
 #endif /* __MTA_HAL_H__ */
 /**
  * @}
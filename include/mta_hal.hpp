@@ -0,0 +1,350 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file mta_hal.hpp
+* @brief Header-only C++20 facade over mta_hal.h.
+*
+* Arrays returned by the HAL are owned by move-only Records objects that release them with the correct deleter,
+* records are exposed as std::span views without copying, fixed size CHAR fields are read through std::string_view,
+* and RETURN_OK/RETURN_ERR/RETURN_TIMEOUT are mapped to the typed Error enumeration.
+*/
+
+#ifndef __MTA_HAL_HPP__
+#define __MTA_HAL_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+extern "C" {
+#include "mta_hal.h"
+}
+
+namespace mta_hal {
+
+/**
+ * @brief Typed result of a HAL call.
+ */
+enum class Error
+{
+    Ok,         /**< RETURN_OK. */
+    Failed,     /**< RETURN_ERR, or any other unexpected return value. */
+    Timeout,    /**< RETURN_TIMEOUT, returned by the ...WithTimeout() variants. */
+    Cancelled,  /**< The request was cancelled before reaching the HAL. Only produced by the async facade. */
+    Busy        /**< The request was rejected because the work queue is full. Only produced by the async facade. */
+};
+
+/**
+ * @brief Map a HAL return value to Error.
+ */
+constexpr Error to_error(INT rc) noexcept
+{
+    return rc == RETURN_OK ? Error::Ok : rc == RETURN_TIMEOUT ? Error::Timeout : Error::Failed;
+}
+
+/**
+ * @brief View the zero-terminated content of a fixed size CHAR field without copying.
+ *        The view stops at the first NUL or at the end of the field, whichever comes first.
+ */
+template <std::size_t N>
+std::string_view field(const CHAR (&buf)[N]) noexcept
+{
+    const void *nul = std::memchr(buf, '\0', N);
+    return std::string_view(buf, nul ? static_cast<std::size_t>(static_cast<const CHAR *>(nul) - buf) : N);
+}
+
+/**
+ * @brief Holds either a value or an Error other than Error::Ok.
+ *
+ * Accessing the value of a Result that holds an error throws std::bad_optional_access.
+ */
+template <typename T>
+class [[nodiscard]] Result
+{
+public:
+    Result(T value) : value_(std::move(value)), error_(Error::Ok) {}
+    Result(Error error) : error_(error == Error::Ok ? Error::Failed : error) {}
+
+    bool has_value() const noexcept { return value_.has_value(); }
+    explicit operator bool() const noexcept { return has_value(); }
+    Error error() const noexcept { return error_; }
+
+    T &value() & { return value_.value(); }
+    const T &value() const & { return value_.value(); }
+    T &&value() && { return std::move(value_.value()); }
+    T *operator->() { return &value_.value(); }
+    const T *operator->() const { return &value_.value(); }
+    T &operator*() & { return value_.value(); }
+    const T &operator*() const & { return value_.value(); }
+
+private:
+    std::optional<T> value_;
+    Error error_;
+};
+
+namespace detail {
+
+/* Arrays returned by the HAL are allocated with malloc() as one block and released by the caller with free(), see mta_hal.h. */
+template <typename T>
+struct RecordsDeleter
+{
+    void operator()(T *p, std::size_t) const noexcept { std::free(p); }
+};
+
+/* MTA log entries additionally own their description string. */
+template <>
+struct RecordsDeleter<MTAMGMT_MTA_MTALOG_FULL>
+{
+    void operator()(MTAMGMT_MTA_MTALOG_FULL *p, std::size_t n) const noexcept
+    {
+        for (std::size_t i = 0; i < n; i++)
+            std::free(p[i].pDescription);
+        std::free(p);
+    }
+};
+
+template <>
+struct RecordsDeleter<MTAMGMT_MTA_MTALOG_FULL_EX>
+{
+    void operator()(MTAMGMT_MTA_MTALOG_FULL_EX *p, std::size_t n) const noexcept
+    {
+        for (std::size_t i = 0; i < n; i++)
+            std::free(p[i].Log.pDescription);
+        std::free(p);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Move-only owner of an array of records returned by the HAL.
+ */
+template <typename T>
+class Records
+{
+public:
+    Records() noexcept = default;
+    Records(T *data, std::size_t count) noexcept : data_(data), count_(data ? count : 0) {}
+    Records(const Records &) = delete;
+    Records &operator=(const Records &) = delete;
+    Records(Records &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), count_(std::exchange(other.count_, 0)) {}
+    Records &operator=(Records &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            count_ = std::exchange(other.count_, 0);
+        }
+        return *this;
+    }
+    ~Records() { reset(); }
+
+    std::span<const T> span() const noexcept { return {data_, count_}; }
+    operator std::span<const T>() const noexcept { return span(); }
+    const T *begin() const noexcept { return data_; }
+    const T *end() const noexcept { return data_ + count_; }
+    const T &operator[](std::size_t i) const noexcept { return data_[i]; }
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    /**
+     * @brief Release the array to the HAL deleter and become empty.
+     */
+    void reset() noexcept
+    {
+        if (data_)
+            detail::RecordsDeleter<T>()(data_, count_);
+        data_ = nullptr;
+        count_ = 0;
+    }
+
+private:
+    T *data_ = nullptr;
+    std::size_t count_ = 0;
+};
+
+namespace detail {
+
+template <typename T, typename Fn>
+Result<Records<T>> fetch(Fn &&fn)
+{
+    ULONG count = 0;
+    T *data = nullptr;
+    Error err = to_error(fn(&count, &data));
+    if (err != Error::Ok)
+        return err;
+    return Records<T>(data, count);
+}
+
+template <typename T, typename Fn>
+Result<T> get(Fn &&fn)
+{
+    T value{};
+    Error err = to_error(fn(&value));
+    if (err != Error::Ok)
+        return err;
+    return value;
+}
+
+/* Negative timeouts become 0 and timeouts beyond the range of ULONG, which may be 32 bits wide, become its maximum. */
+inline ULONG to_ms(std::chrono::milliseconds timeout) noexcept
+{
+    constexpr auto max = std::numeric_limits<ULONG>::max();
+    if (timeout.count() <= 0)
+        return 0;
+    if (static_cast<unsigned long long>(timeout.count()) >= max)
+        return max;
+    return static_cast<ULONG>(timeout.count());
+}
+
+} // namespace detail
+
+inline Result<Records<MTAMGMT_MTA_SERVICE_FLOW>> get_service_flows()
+{
+    return detail::fetch<MTAMGMT_MTA_SERVICE_FLOW>([](ULONG *n, PMTAMGMT_MTA_SERVICE_FLOW *p) { return mta_hal_GetServiceFlow(n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_HANDSETS_INFO>> get_handsets()
+{
+    return detail::fetch<MTAMGMT_MTA_HANDSETS_INFO>([](ULONG *n, PMTAMGMT_MTA_HANDSETS_INFO *p) { return mta_hal_GetHandsets(n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_CALLS>> get_calls(ULONG instanceNumber)
+{
+    return detail::fetch<MTAMGMT_MTA_CALLS>([=](ULONG *n, PMTAMGMT_MTA_CALLS *p) { return mta_hal_GetCalls(instanceNumber, n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_CALLS_EX>> get_calls_ex(ULONG instanceNumber)
+{
+    return detail::fetch<MTAMGMT_MTA_CALLS_EX>([=](ULONG *n, PMTAMGMT_MTA_CALLS_EX *p) { return mta_hal_GetCallsEx(instanceNumber, n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_CALLS_EX>> query_calls(ULONG instanceNumber, const MTAMGMT_MTA_CALL_FILTER &filter)
+{
+    return detail::fetch<MTAMGMT_MTA_CALLS_EX>([&](ULONG *n, PMTAMGMT_MTA_CALLS_EX *p) { return mta_hal_QueryCalls(instanceNumber, &filter, n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_DSXLOG>> get_dsx_logs()
+{
+    return detail::fetch<MTAMGMT_MTA_DSXLOG>([](ULONG *n, PMTAMGMT_MTA_DSXLOG *p) { return mta_hal_GetDSXLogs(n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_DSXLOG_EX>> query_dsx_logs(const MTAMGMT_MTA_LOG_FILTER &filter)
+{
+    return detail::fetch<MTAMGMT_MTA_DSXLOG_EX>([&](ULONG *n, PMTAMGMT_MTA_DSXLOG_EX *p) { return mta_hal_QueryDSXLogs(&filter, n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_MTALOG_FULL>> get_mta_log()
+{
+    return detail::fetch<MTAMGMT_MTA_MTALOG_FULL>([](ULONG *n, PMTAMGMT_MTA_MTALOG_FULL *p) { return mta_hal_GetMtaLog(n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_MTALOG_FULL_EX>> query_mta_log(const MTAMGMT_MTA_LOG_FILTER &filter)
+{
+    return detail::fetch<MTAMGMT_MTA_MTALOG_FULL_EX>([&](ULONG *n, PMTAMGMT_MTA_MTALOG_FULL_EX *p) { return mta_hal_QueryMtaLog(&filter, n, p); });
+}
+
+inline Result<Records<MTAMGMT_MTA_CALLS>> get_calls(ULONG instanceNumber, std::chrono::milliseconds timeout)
+{
+    return detail::fetch<MTAMGMT_MTA_CALLS>([=](ULONG *n, PMTAMGMT_MTA_CALLS *p) { return mta_hal_GetCallsWithTimeout(instanceNumber, n, p, detail::to_ms(timeout)); });
+}
+
+inline Result<MTAMGMT_MTA_DHCP_INFO> get_dhcp_info()
+{
+    return detail::get<MTAMGMT_MTA_DHCP_INFO>(mta_hal_GetDHCPInfo);
+}
+
+inline Result<MTAMGMT_MTA_DHCP_INFO> get_dhcp_info(std::chrono::milliseconds timeout)
+{
+    return detail::get<MTAMGMT_MTA_DHCP_INFO>([=](PMTAMGMT_MTA_DHCP_INFO p) { return mta_hal_GetDHCPInfoWithTimeout(p, detail::to_ms(timeout)); });
+}
+
+inline Result<MTAMGMT_MTA_DHCPv6_INFO> get_dhcpv6_info()
+{
+    return detail::get<MTAMGMT_MTA_DHCPv6_INFO>(mta_hal_GetDHCPV6Info);
+}
+
+inline Result<MTAMGMT_MTA_DHCP_INFO_BIN> get_dhcp_info_bin()
+{
+    return detail::get<MTAMGMT_MTA_DHCP_INFO_BIN>(mta_hal_GetDHCPInfoBin);
+}
+
+inline Result<MTAMGMT_MTA_DHCPv6_INFO_BIN> get_dhcpv6_info_bin()
+{
+    return detail::get<MTAMGMT_MTA_DHCPv6_INFO_BIN>(mta_hal_GetDHCPV6InfoBin);
+}
+
+/**
+ * @brief Line table entry together with the call records the HAL returned in it.
+ *
+ * info.pCalls is always NULL; the records it pointed to are owned by calls and released with it.
+ */
+struct LineTableEntry
+{
+    MTAMGMT_MTA_LINETABLE_INFO info;
+    Records<MTAMGMT_MTA_CALLS> calls;
+};
+
+inline Result<LineTableEntry> get_line_table_entry(ULONG index)
+{
+    LineTableEntry entry{};
+    Error err = to_error(mta_hal_LineTableGetEntry(index, &entry.info));
+    if (err != Error::Ok)
+        return err;
+    entry.calls = Records<MTAMGMT_MTA_CALLS>(std::exchange(entry.info.pCalls, nullptr), entry.info.CallsNumber);
+    return entry;
+}
+
+inline Result<MTAMGMT_MTA_CALLP> get_callp(ULONG lineNumber)
+{
+    return detail::get<MTAMGMT_MTA_CALLP>([=](PMTAMGMT_MTA_CALLP p) { return mta_hal_GetCALLP(lineNumber, p); });
+}
+
+inline Result<MTAMGMT_MTA_DECT> get_dect()
+{
+    return detail::get<MTAMGMT_MTA_DECT>(mta_hal_GetDect);
+}
+
+inline Result<MTAMGMT_MTA_BATTERY_INFO> get_battery_info()
+{
+    return detail::get<MTAMGMT_MTA_BATTERY_INFO>(mta_hal_BatteryGetInfo);
+}
+
+inline Result<MTAMGMT_MTA_MEMORY_USAGE> get_memory_usage()
+{
+    return detail::get<MTAMGMT_MTA_MEMORY_USAGE>(mta_hal_GetMemoryUsage);
+}
+
+inline Result<MTAMGMT_MTA_HEALTH_SNAPSHOT> get_health_snapshot()
+{
+    return detail::get<MTAMGMT_MTA_HEALTH_SNAPSHOT>(mta_hal_GetHealthSnapshot);
+}
+
+} // namespace mta_hal
+
+#endif /* __MTA_HAL_HPP__ */
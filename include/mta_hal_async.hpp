@@ -0,0 +1,460 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file mta_hal_async.hpp
+* @brief Header-only C++20 asynchronous executor for the blocking mta_hal.hpp calls.
+*
+* HAL calls run on a small, bounded pool of worker threads and complete through std::shared_future or co_await.
+* Awaiting coroutines are resumed through a Scheduler, never on the worker that ran the call.
+* Concurrent requests with the same key are coalesced into a single HAL call whose result is shared by all requesters,
+* and requests that every requester has cancelled before they start never reach the HAL. Link with -pthread.
+*/
+
+#ifndef __MTA_HAL_ASYNC_HPP__
+#define __MTA_HAL_ASYNC_HPP__
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "mta_hal.hpp"
+
+namespace mta_hal {
+
+/**
+ * @brief Resumes a coroutine that awaited a Pending request, on a thread of the caller's choice.
+ */
+using Scheduler = std::function<void(std::coroutine_handle<>)>;
+
+namespace detail {
+
+class JobBase
+{
+public:
+    JobBase(std::string key, Scheduler scheduler) : key_(std::move(key)), scheduler_(std::move(scheduler)) {}
+    virtual ~JobBase() = default;
+
+    /* Run the HAL call. */
+    virtual void run() = 0;
+    /* Complete with Error::Cancelled without calling the HAL. */
+    virtual void abandon() = 0;
+
+    const std::string &key() const noexcept { return key_; }
+
+    void add_interest()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        interest_++;
+    }
+
+    void drop_interest()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (interest_ > 0)
+            interest_--;
+    }
+
+    bool wanted()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return interest_ > 0;
+    }
+
+    /* Returns false, without suspending, if the job has already completed. */
+    bool add_continuation(std::coroutine_handle<> h)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done_)
+            return false;
+        continuations_.push_back(h);
+        return true;
+    }
+
+protected:
+    /* Hand awaiting coroutines to the scheduler, never resuming them on the worker thread. */
+    void finish()
+    {
+        std::vector<std::coroutine_handle<>> resume;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+            resume.swap(continuations_);
+        }
+        for (auto h : resume)
+            scheduler_(h);
+    }
+
+private:
+    std::string key_;
+    Scheduler scheduler_;
+    std::mutex mutex_;
+    unsigned interest_ = 1;
+    bool done_ = false;
+    std::vector<std::coroutine_handle<>> continuations_;
+};
+
+template <typename T>
+class Job : public JobBase
+{
+public:
+    using Shared = std::shared_ptr<const Result<T>>;
+
+    Job(std::string key, Scheduler scheduler, std::function<Result<T>()> fn)
+        : JobBase(std::move(key), std::move(scheduler)), fn_(std::move(fn)), future_(promise_.get_future().share()) {}
+
+    void run() override
+    {
+        try
+        {
+            promise_.set_value(std::make_shared<const Result<T>>(fn_()));
+        }
+        catch (...)
+        {
+            promise_.set_exception(std::current_exception());
+        }
+        finish();
+    }
+
+    void abandon() override
+    {
+        promise_.set_value(std::make_shared<const Result<T>>(Error::Cancelled));
+        finish();
+    }
+
+    const std::shared_future<Shared> &future() const noexcept { return future_; }
+
+private:
+    std::function<Result<T>()> fn_;
+    std::promise<Shared> promise_;
+    std::shared_future<Shared> future_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Handle to an asynchronous HAL request.
+ *
+ * Coalesced requests share the same result, so it is only available by const reference or through a shared owner.
+ * On an lvalue handle, get() and co_await return a reference that stays valid while the handle is alive.
+ * On a temporary, such as co_await ex.get_calls(1), they return a std::shared_ptr<const Result<T>> that owns the result.
+ * Destroying or assigning over the handle withdraws its interest as cancel() does.
+ * An exception thrown by the request is rethrown by get() and co_await.
+ */
+template <typename T>
+class Pending
+{
+public:
+    using Shared = std::shared_ptr<const Result<T>>;
+
+    Pending(std::shared_ptr<detail::Job<T>> job) : job_(std::move(job)), future_(job_->future()), interested_(true) {}
+
+    /* Rejected request, completed immediately with the given error. */
+    explicit Pending(Error error)
+    {
+        std::promise<Shared> promise;
+        promise.set_value(std::make_shared<const Result<T>>(error));
+        future_ = promise.get_future().share();
+    }
+
+    Pending(const Pending &) = delete;
+    Pending &operator=(const Pending &) = delete;
+    Pending(Pending &&other) noexcept
+        : job_(std::move(other.job_)), future_(std::move(other.future_)), interested_(std::exchange(other.interested_, false)) {}
+    Pending &operator=(Pending &&other) noexcept
+    {
+        if (this != &other)
+        {
+            cancel();
+            job_ = std::move(other.job_);
+            future_ = std::move(other.future_);
+            interested_ = std::exchange(other.interested_, false);
+        }
+        return *this;
+    }
+    ~Pending() { cancel(); }
+
+    const std::shared_future<Shared> &future() const noexcept { return future_; }
+    const Result<T> &get() const & { return *future_.get(); }
+    Shared get() && { return future_.get(); }
+    bool ready() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    /**
+     * @brief Withdraw this requester's interest.
+     *        The HAL call is skipped, and completes with Error::Cancelled, if no coalesced requester is still interested when it is dequeued.
+     *        A call already running is not interrupted. The handle can still be waited on.
+     */
+    void cancel()
+    {
+        if (interested_)
+        {
+            job_->drop_interest();
+            interested_ = false;
+        }
+    }
+
+    class Awaiter
+    {
+    public:
+        explicit Awaiter(Pending &pending) : pending_(pending) {}
+        bool await_ready() const { return pending_.ready(); }
+        bool await_suspend(std::coroutine_handle<> h) { return pending_.job_ ? pending_.job_->add_continuation(h) : false; }
+        const Result<T> &await_resume() const { return pending_.get(); }
+
+    private:
+        Pending &pending_;
+    };
+
+    class OwningAwaiter
+    {
+    public:
+        explicit OwningAwaiter(Pending &&pending) : pending_(std::move(pending)) {}
+        bool await_ready() const { return pending_.ready(); }
+        bool await_suspend(std::coroutine_handle<> h) { return pending_.job_ ? pending_.job_->add_continuation(h) : false; }
+        Shared await_resume() { return std::move(pending_).get(); }
+
+    private:
+        Pending pending_;
+    };
+
+    Awaiter operator co_await() & { return Awaiter(*this); }
+    OwningAwaiter operator co_await() && { return OwningAwaiter(std::move(*this)); }
+
+private:
+    std::shared_ptr<detail::Job<T>> job_;
+    std::shared_future<Shared> future_;
+    bool interested_ = false;
+};
+
+/**
+ * @brief Bounded worker pool running HAL calls.
+ *
+ * Coroutines awaiting a request are never resumed on a worker, so consumer code cannot occupy the pool or deadlock it by
+ * waiting on another request. They are resumed by the Scheduler given to the constructor or, by default, on a completion
+ * thread owned by the executor. Continuations on that thread run one at a time, so they should not block for long,
+ * and must not destroy the executor.
+ */
+class Executor
+{
+public:
+    /**
+     * @param workers Number of worker threads, i.e. the maximum number of concurrent HAL calls. Use 1 unless the HAL implementation is thread-safe.
+     * @param queueDepth Maximum number of requests waiting for a worker. Further requests complete with Error::Busy.
+     * @param scheduler Resumes awaiting coroutines, e.g. by posting them to the caller's event loop. Called from a worker thread,
+     *                  so it must only enqueue, and must stay callable until the executor is destroyed.
+     *                  When empty, coroutines are resumed on a completion thread owned by the executor.
+     */
+    explicit Executor(std::size_t workers = 1, std::size_t queueDepth = 32, Scheduler scheduler = {})
+        : queueDepth_(queueDepth), scheduler_(std::move(scheduler))
+    {
+        if (!scheduler_)
+        {
+            completionThread_ = std::thread([this] { complete(); });
+            scheduler_ = [this](std::coroutine_handle<> h) {
+                {
+                    std::lock_guard<std::mutex> lock(completionMutex_);
+                    completions_.push_back(h);
+                }
+                completionCv_.notify_one();
+            };
+        }
+        for (std::size_t i = 0; i < (workers ? workers : 1); i++)
+            threads_.emplace_back([this] { work(); });
+    }
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    /* Queued requests complete with Error::Cancelled; running HAL calls are waited for, then pending continuations are resumed. */
+    ~Executor()
+    {
+        std::deque<std::shared_ptr<detail::JobBase>> left;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            left.swap(queue_);
+            inflight_.clear();
+        }
+        cv_.notify_all();
+        for (auto &t : threads_)
+            t.join();
+        for (auto &job : left)
+            job->abandon();
+        if (completionThread_.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(completionMutex_);
+                completionStop_ = true;
+            }
+            completionCv_.notify_one();
+            completionThread_.join();
+        }
+    }
+
+    /**
+     * @brief Queue a HAL call.
+     * @param key Coalescing key. A request whose key matches a queued or running request of the same type joins it instead of queueing a new call.
+     *            Requests with an empty key are never coalesced.
+     * @param fn The call to run on a worker thread. An exception it throws completes the request exceptionally.
+     */
+    template <typename T>
+    Pending<T> submit(std::string key, std::function<Result<T>()> fn)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!key.empty())
+        {
+            auto it = inflight_.find(key);
+            if (it != inflight_.end())
+            {
+                if (auto job = std::dynamic_pointer_cast<detail::Job<T>>(it->second.lock()))
+                {
+                    job->add_interest();
+                    return Pending<T>(std::move(job));
+                }
+            }
+        }
+        if (stop_ || queue_.size() >= queueDepth_)
+            return Pending<T>(Error::Busy);
+        auto job = std::make_shared<detail::Job<T>>(key, scheduler_, std::move(fn));
+        if (!key.empty())
+            inflight_[key] = job;
+        queue_.push_back(job);
+        cv_.notify_one();
+        return Pending<T>(std::move(job));
+    }
+
+    Pending<MTAMGMT_MTA_DHCP_INFO> get_dhcp_info()
+    {
+        return submit<MTAMGMT_MTA_DHCP_INFO>("dhcp", [] { return mta_hal::get_dhcp_info(); });
+    }
+
+    Pending<MTAMGMT_MTA_DHCPv6_INFO> get_dhcpv6_info()
+    {
+        return submit<MTAMGMT_MTA_DHCPv6_INFO>("dhcpv6", [] { return mta_hal::get_dhcpv6_info(); });
+    }
+
+    Pending<Records<MTAMGMT_MTA_SERVICE_FLOW>> get_service_flows()
+    {
+        return submit<Records<MTAMGMT_MTA_SERVICE_FLOW>>("serviceflows", [] { return mta_hal::get_service_flows(); });
+    }
+
+    Pending<Records<MTAMGMT_MTA_HANDSETS_INFO>> get_handsets()
+    {
+        return submit<Records<MTAMGMT_MTA_HANDSETS_INFO>>("handsets", [] { return mta_hal::get_handsets(); });
+    }
+
+    Pending<Records<MTAMGMT_MTA_CALLS>> get_calls(ULONG instanceNumber)
+    {
+        return submit<Records<MTAMGMT_MTA_CALLS>>("calls/" + std::to_string(instanceNumber), [=] { return mta_hal::get_calls(instanceNumber); });
+    }
+
+    Pending<Records<MTAMGMT_MTA_DSXLOG>> get_dsx_logs()
+    {
+        return submit<Records<MTAMGMT_MTA_DSXLOG>>("dsxlogs", [] { return mta_hal::get_dsx_logs(); });
+    }
+
+    Pending<Records<MTAMGMT_MTA_MTALOG_FULL>> get_mta_log()
+    {
+        return submit<Records<MTAMGMT_MTA_MTALOG_FULL>>("mtalog", [] { return mta_hal::get_mta_log(); });
+    }
+
+private:
+    void work()
+    {
+        for (;;)
+        {
+            std::shared_ptr<detail::JobBase> job;
+            bool run = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_)
+                    return;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                /*
+                 * Decide under the coalescing lock, so that submit() cannot join a job that is about to be abandoned:
+                 * an unwanted job leaves inflight_ before any new requester can find it.
+                 */
+                run = job->wanted();
+                if (!run)
+                    forget(job);
+            }
+            if (!run)
+            {
+                job->abandon();
+                continue;
+            }
+            job->run();
+            std::lock_guard<std::mutex> lock(mutex_);
+            forget(job);
+        }
+    }
+
+    /* Called with mutex_ held. */
+    void forget(const std::shared_ptr<detail::JobBase> &job)
+    {
+        auto it = inflight_.find(job->key());
+        if (it != inflight_.end() && it->second.lock() == job)
+            inflight_.erase(it);
+    }
+
+    void complete()
+    {
+        for (;;)
+        {
+            std::coroutine_handle<> h;
+            {
+                std::unique_lock<std::mutex> lock(completionMutex_);
+                completionCv_.wait(lock, [this] { return completionStop_ || !completions_.empty(); });
+                if (completions_.empty())
+                    return;
+                h = completions_.front();
+                completions_.pop_front();
+            }
+            h.resume();
+        }
+    }
+
+    std::size_t queueDepth_;
+    Scheduler scheduler_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::deque<std::shared_ptr<detail::JobBase>> queue_;
+    std::unordered_map<std::string, std::weak_ptr<detail::JobBase>> inflight_;
+    std::vector<std::thread> threads_;
+    std::mutex completionMutex_;
+    std::condition_variable completionCv_;
+    bool completionStop_ = false;
+    std::deque<std::coroutine_handle<>> completions_;
+    std::thread completionThread_;
+};
+
+} // namespace mta_hal
+
+#endif /* __MTA_HAL_ASYNC_HPP__ */
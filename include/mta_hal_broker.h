@@ -0,0 +1,168 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file mta_hal_broker.h
+* @brief Wire protocol and control interface of the optional MTA HAL broker.
+*
+* The broker daemon is the only process that loads the real `libhal_mta.so`. Client processes link the broker client library
+* (`libhal_mta_client.so`) instead, which exports the complete `mta_hal.h` API and forwards each call to the daemon over a Unix
+* stream socket. The daemon serialises calls into the HAL, answers reads from a per-table cache with a configurable TTL, coalesces
+* identical concurrent reads into one HAL call, and pushes state changes to clients, which the client library turns into the usual
+* callbacks and event descriptor notifications. Hardware traffic is therefore independent of the number of client processes.
+*/
+
+#ifndef __MTA_HAL_BROKER_H__
+#define __MTA_HAL_BROKER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mta_hal_record.h"
+
+/**
+ * @addtogroup MTA_HAL_TYPES
+ * @{
+ */
+
+#define MTA_HAL_BROKER_MAGIC          0x4B52424D    /**< "MBRK" in little-endian byte order. */
+#define MTA_HAL_BROKER_VERSION        1
+
+#ifndef MTA_HAL_BROKER_SOCKET
+#define MTA_HAL_BROKER_SOCKET         "/var/run/mta_hal_broker.sock"   /**< Default path of the broker socket. */
+#endif
+
+#ifndef MTA_HAL_BROKER_SOCKET_ENV
+#define MTA_HAL_BROKER_SOCKET_ENV     "MTA_HAL_BROKER_SOCKET"          /**< Environment variable overriding the socket path, for both daemon and clients. */
+#endif
+
+/**
+ * @brief Represents the kind of a broker message.
+ */
+typedef enum {
+   MTA_HAL_BROKER_REQUEST=1,       /**< Client to daemon: a HAL call. */
+   MTA_HAL_BROKER_RESPONSE=2,      /**< Daemon to client: the result of the request with the same Sequence. */
+   MTA_HAL_BROKER_PUSH=3,          /**< Daemon to client: a callback invocation or pending events, see MTA_HAL_BROKER_MSG. */
+   MTA_HAL_BROKER_SUBSCRIBE=4      /**< Client to daemon: set the MTA_EVENT_* bits, held in Index, for which the client wants MTA_HAL_REC_CB_EVENTS pushes. */
+} MTA_HAL_BROKER_MSG_TYPE;
+
+/**
+ * @brief Header of every broker message, immediately followed by PayloadSize bytes of payload.
+ *
+ * Every function of mta_hal.h and of this header is forwarded under its own MTA_HAL_RECORD_API value. Index follows the
+ * rule of MTA_HAL_RECORD_ENTRY, and the payload uses its fixed-width encoding, pointer members included:
+ * a request carries the request part, with the input arguments, and its response carries the response part, with the outputs.
+ * Arrays and strings reached through a pointer member, such as the CallsNumber records of MTAMGMT_MTA_LINETABLE_INFO.pCalls,
+ * travel in the trailer of the response, and the client library copies them into memory allocated with malloc(), which the
+ * caller owns as mta_hal.h requires.
+ * Messages are exchanged in host byte order, as both ends run on the same device.
+ *
+ * Callback pointers, pUserData and event descriptors never cross the socket; the client library keeps them and maps them to messages:
+ * - A callback registration or subscription is sent as a request under its own ApiId, without the callback arguments.
+ *   The daemon installs one callback of each type in the HAL and returns the subscription identifier, if any, in the response.
+ * - Each invocation is pushed to the clients that registered for it, with the MTA_HAL_REC_CB_* value as ApiId and the callback
+ *   arguments as payload. Index holds the subscription identifier for subscribers, or the RequestId for mta_hal_diagnostics_callback.
+ * - mta_hal_OpenEventFd() creates a local descriptor and sends MTA_HAL_BROKER_SUBSCRIBE. MTA_HAL_REC_CB_EVENTS pushes set
+ *   the pending bits reported by mta_hal_DrainEvents(), which is answered locally.
+ */
+typedef struct _MTA_HAL_BROKER_MSG
+{
+    uint32_t Magic;                  /**< MTA_HAL_BROKER_MAGIC. */
+    uint16_t Version;                /**< MTA_HAL_BROKER_VERSION. */
+    uint16_t Type;                   /**< MTA_HAL_BROKER_MSG_TYPE value. */
+    uint32_t Sequence;               /**< Chosen by the client for requests and echoed in the response. 0 for pushes. */
+    uint16_t ApiId;                  /**< MTA_HAL_RECORD_API value. */
+    uint16_t Flags;                  /**< MTA_HAL_BROKER_FLAG_* values. */
+    int32_t  Status;                 /**< Return value of the HAL call, in responses. */
+    uint32_t Index;                  /**< As MTA_HAL_RECORD_ENTRY.Index for requests and responses; see above for pushes and subscriptions. */
+    uint32_t Count;                  /**< As MTA_HAL_RECORD_ENTRY.Count, in responses. Otherwise 0. */
+    uint32_t PayloadSize;            /**< Size of the payload following this header, in bytes. */
+} MTA_HAL_BROKER_MSG;
+
+#define MTA_HAL_BROKER_FLAG_NO_CACHE  0x0001   /**< Request: bypass the cache and read from the HAL. */
+#define MTA_HAL_BROKER_FLAG_CACHED    0x0002   /**< Response: served from the cache. */
+
+/**
+ * @brief Represents the cached tables of the broker, each with its own TTL.
+ */
+typedef enum {
+   MTA_HAL_BROKER_TABLE_DHCP=0,             /**< DHCP and DHCPv6 information. */
+   MTA_HAL_BROKER_TABLE_LINE_TABLE=1,       /**< Line table entries and call processing status. */
+   MTA_HAL_BROKER_TABLE_CALLS=2,            /**< Call records. */
+   MTA_HAL_BROKER_TABLE_SERVICE_FLOW=3,     /**< Service flows. */
+   MTA_HAL_BROKER_TABLE_DECT=4,             /**< DECT and handsets. */
+   MTA_HAL_BROKER_TABLE_BATTERY=5,          /**< Battery. */
+   MTA_HAL_BROKER_TABLE_LOGS=6,             /**< DSX and MTA logs. */
+   MTA_HAL_BROKER_TABLE_STATUS=7,           /**< Status getters and the health snapshot. */
+   MTA_HAL_BROKER_TABLE_MAX=8               /**< Number of tables, not a valid table. */
+} MTA_HAL_BROKER_TABLE;
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup MTA_HAL_APIS
+ * @{
+ */
+
+/**
+* @brief Set the cache TTL of a broker table. Served by the broker; may be called by any client.
+*        A write through the broker, and any push affecting the table, invalidates its cache regardless of the TTL.
+* @param[in] Table - Table from MTA_HAL_BROKER_TABLE enumeration.
+* @param[in] TtlMs - Time a cached read stays valid, in milliseconds. 0 disables caching for the table; concurrent reads are still coalesced.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the broker is not reachable.
+*
+*/
+INT mta_hal_broker_SetCacheTtl(MTA_HAL_BROKER_TABLE Table, ULONG TtlMs);
+
+/**
+* @brief Get the cache TTL of a broker table.
+* @param[in] Table - Table from MTA_HAL_BROKER_TABLE enumeration.
+* @param[out] pTtlMs - Time a cached read stays valid, in milliseconds, to be returned.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the broker is not reachable.
+*
+*/
+INT mta_hal_broker_GetCacheTtl(MTA_HAL_BROKER_TABLE Table, ULONG *pTtlMs);
+
+/**
+* @brief Invalidate the cache of every broker table, so the next read of each goes to the HAL.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the broker is not reachable.
+*
+*/
+INT mta_hal_broker_FlushCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MTA_HAL_BROKER_H__ */
+/**
+ * @}
+ */
@@ -0,0 +1,300 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file mta_hal_record.h
+* @brief Capture file format and control interface for the MTA HAL record and replay shims.
+*
+* The recorder shim (`libhal_mta_record.so`) exports the complete `mta_hal.h` API, forwards every call to the real
+* `libhal_mta.so` and appends the request and response to a capture file. The replay backend (`libhal_mta_replay.so`)
+* exports the same API and serves the responses of a capture file, at recorded or accelerated timing, without any hardware.
+* Both are drop-in replacements for `libhal_mta.so`, so consumers are benchmarked unmodified.
+*/
+
+#ifndef __MTA_HAL_RECORD_H__
+#define __MTA_HAL_RECORD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mta_hal.h"
+
+/**
+ * @addtogroup MTA_HAL_TYPES
+ * @{
+ */
+
+#define MTA_HAL_RECORD_MAGIC       0x5241544D    /**< "MTAR" in little-endian byte order. */
+#define MTA_HAL_RECORD_VERSION     2
+
+#ifndef MTA_HAL_RECORD_TARGET_ENV
+#define MTA_HAL_RECORD_TARGET_ENV  "MTA_HAL_RECORD_TARGET"   /**< Environment variable holding the path of the real HAL loaded by the recorder. Defaults to libhal_mta.so. */
+#endif
+
+#ifndef MTA_HAL_RECORD_FILE_ENV
+#define MTA_HAL_RECORD_FILE_ENV    "MTA_HAL_RECORD_FILE"     /**< Environment variable holding the capture file path. Recording starts at load time when set. */
+#endif
+
+/**
+ * @brief Identifies the HAL function, or the callback invocation, of a capture file entry.
+ *
+ * There is one value per function of mta_hal.h and one per callback type. Values are part of the file format: new functions are
+ * appended and existing values are never renumbered or reused. Callback values identify invocations made by the HAL; the
+ * registration and subscription calls that install them have their own values.
+ */
+typedef enum {
+   MTA_HAL_REC_INIT_DB=1,                                        /**< mta_hal_InitDB() */
+   MTA_HAL_REC_GET_DHCP_INFO=2,                                  /**< mta_hal_GetDHCPInfo() */
+   MTA_HAL_REC_GET_DHCPV6_INFO=3,                                /**< mta_hal_GetDHCPV6Info() */
+   MTA_HAL_REC_LINETABLE_GET_NUM_ENTRIES=4,                      /**< mta_hal_LineTableGetNumberOfEntries() */
+   MTA_HAL_REC_LINETABLE_GET_ENTRY=5,                            /**< mta_hal_LineTableGetEntry() */
+   MTA_HAL_REC_GET_SERVICE_FLOW=6,                               /**< mta_hal_GetServiceFlow() */
+   MTA_HAL_REC_GET_DECT=7,                                       /**< mta_hal_GetDect() */
+   MTA_HAL_REC_GET_HANDSETS=8,                                   /**< mta_hal_GetHandsets() */
+   MTA_HAL_REC_GET_CALLS=9,                                      /**< mta_hal_GetCalls() */
+   MTA_HAL_REC_GET_CALLP=10,                                     /**< mta_hal_GetCALLP() */
+   MTA_HAL_REC_GET_DSX_LOGS=11,                                  /**< mta_hal_GetDSXLogs() */
+   MTA_HAL_REC_GET_MTA_LOG=12,                                   /**< mta_hal_GetMtaLog() */
+   MTA_HAL_REC_INIT_DB_EX=13,                                    /**< mta_hal_InitDBEx() */
+   MTA_HAL_REC_INIT_SUBSYSTEM=14,                                /**< mta_hal_InitSubsystem() */
+   MTA_HAL_REC_GET_SUBSYSTEM_STATUS=15,                          /**< mta_hal_GetSubsystemStatus() */
+   MTA_HAL_REC_GET_DHCP_INFO_BIN=16,                             /**< mta_hal_GetDHCPInfoBin() */
+   MTA_HAL_REC_GET_DHCPV6_INFO_BIN=17,                           /**< mta_hal_GetDHCPV6InfoBin() */
+   MTA_HAL_REC_TRIGGER_DIAGNOSTICS=18,                           /**< mta_hal_TriggerDiagnostics() */
+   MTA_HAL_REC_DECT_GET_ENABLE=19,                               /**< mta_hal_DectGetEnable() */
+   MTA_HAL_REC_DECT_SET_ENABLE=20,                               /**< mta_hal_DectSetEnable() */
+   MTA_HAL_REC_DECT_GET_REGISTRATION_MODE=21,                    /**< mta_hal_DectGetRegistrationMode() */
+   MTA_HAL_REC_DECT_SET_REGISTRATION_MODE=22,                    /**< mta_hal_DectSetRegistrationMode() */
+   MTA_HAL_REC_DECT_DEREGISTER_HANDSET=23,                       /**< mta_hal_DectDeregisterDectHandset() */
+   MTA_HAL_REC_GET_DECT_PIN=24,                                  /**< mta_hal_GetDectPIN() */
+   MTA_HAL_REC_SET_DECT_PIN=25,                                  /**< mta_hal_SetDectPIN() */
+   MTA_HAL_REC_GET_CALLS_EX=26,                                  /**< mta_hal_GetCallsEx() */
+   MTA_HAL_REC_QUERY_CALLS=27,                                   /**< mta_hal_QueryCalls() */
+   MTA_HAL_REC_GET_DSX_LOGS_EX=28,                               /**< mta_hal_GetDSXLogsEx() */
+   MTA_HAL_REC_GET_DSX_LOG_ENABLE=29,                            /**< mta_hal_GetDSXLogEnable() */
+   MTA_HAL_REC_SET_DSX_LOG_ENABLE=30,                            /**< mta_hal_SetDSXLogEnable() */
+   MTA_HAL_REC_CLEAR_DSX_LOG=31,                                 /**< mta_hal_ClearDSXLog() */
+   MTA_HAL_REC_GET_CALL_SIGNALLING_LOG_ENABLE=32,                /**< mta_hal_GetCallSignallingLogEnable() */
+   MTA_HAL_REC_SET_CALL_SIGNALLING_LOG_ENABLE=33,                /**< mta_hal_SetCallSignallingLogEnable() */
+   MTA_HAL_REC_CLEAR_CALL_SIGNALLING_LOG=34,                     /**< mta_hal_ClearCallSignallingLog() */
+   MTA_HAL_REC_GET_MTA_LOG_EX=35,                                /**< mta_hal_GetMtaLogEx() */
+   MTA_HAL_REC_QUERY_DSX_LOGS=36,                                /**< mta_hal_QueryDSXLogs() */
+   MTA_HAL_REC_QUERY_MTA_LOG=37,                                 /**< mta_hal_QueryMtaLog() */
+   MTA_HAL_REC_BATTERY_GET_INSTALLED=38,                         /**< mta_hal_BatteryGetInstalled() */
+   MTA_HAL_REC_BATTERY_GET_TOTAL_CAPACITY=39,                    /**< mta_hal_BatteryGetTotalCapacity() */
+   MTA_HAL_REC_BATTERY_GET_ACTUAL_CAPACITY=40,                   /**< mta_hal_BatteryGetActualCapacity() */
+   MTA_HAL_REC_BATTERY_GET_REMAINING_CHARGE=41,                  /**< mta_hal_BatteryGetRemainingCharge() */
+   MTA_HAL_REC_BATTERY_GET_REMAINING_TIME=42,                    /**< mta_hal_BatteryGetRemainingTime() */
+   MTA_HAL_REC_BATTERY_GET_NUMBER_OF_CYCLES=43,                  /**< mta_hal_BatteryGetNumberofCycles() */
+   MTA_HAL_REC_BATTERY_GET_POWER_STATUS=44,                      /**< mta_hal_BatteryGetPowerStatus() */
+   MTA_HAL_REC_BATTERY_GET_CONDITION=45,                         /**< mta_hal_BatteryGetCondition() */
+   MTA_HAL_REC_BATTERY_GET_STATUS=46,                            /**< mta_hal_BatteryGetStatus() */
+   MTA_HAL_REC_BATTERY_GET_LIFE=47,                              /**< mta_hal_BatteryGetLife() */
+   MTA_HAL_REC_BATTERY_GET_INFO=48,                              /**< mta_hal_BatteryGetInfo() */
+   MTA_HAL_REC_BATTERY_GET_POWER_SAVING_MODE_STATUS=49,          /**< mta_hal_BatteryGetPowerSavingModeStatus() */
+   MTA_HAL_REC_GET_MTA_RESET_COUNT=50,                           /**< mta_hal_Get_MTAResetCount() */
+   MTA_HAL_REC_GET_LINE_RESET_COUNT=51,                          /**< mta_hal_Get_LineResetCount() */
+   MTA_HAL_REC_CLEAR_CALLS=52,                                   /**< mta_hal_ClearCalls() */
+   MTA_HAL_REC_GET_CALL_HISTORY_CONFIG=53,                       /**< mta_hal_GetCallHistoryConfig() */
+   MTA_HAL_REC_SET_CALL_HISTORY_CONFIG=54,                       /**< mta_hal_SetCallHistoryConfig() */
+   MTA_HAL_REC_GET_CALL_HISTORY_OCCUPANCY=55,                    /**< mta_hal_GetCallHistoryOccupancy() */
+   MTA_HAL_REC_GET_DHCP_STATUS=56,                               /**< mta_hal_getDhcpStatus() */
+   MTA_HAL_REC_GET_CONFIG_FILE_STATUS=57,                        /**< mta_hal_getConfigFileStatus() */
+   MTA_HAL_REC_GET_LINE_REGISTER_STATUS=58,                      /**< mta_hal_getLineRegisterStatus() */
+   MTA_HAL_REC_DEV_RESET_NOW=59,                                 /**< mta_hal_devResetNow() */
+   MTA_HAL_REC_GET_MTA_OPERATIONAL_STATUS=60,                    /**< mta_hal_getMtaOperationalStatus() */
+   MTA_HAL_REC_GET_MTA_PROVISIONING_STATUS=61,                   /**< mta_hal_getMtaProvisioningStatus() */
+   MTA_HAL_REC_GET_HEALTH_SNAPSHOT=62,                           /**< mta_hal_GetHealthSnapshot() */
+   MTA_HAL_REC_START_PROVISIONING=63,                            /**< mta_hal_start_provisioning() */
+   MTA_HAL_REC_START_PROVISIONING_EX=64,                         /**< mta_hal_start_provisioning_ex() */
+   MTA_HAL_REC_GET_WARM_START_INFO=65,                           /**< mta_hal_GetWarmStartInfo() */
+   MTA_HAL_REC_CLEAR_WARM_START_INFO=66,                         /**< mta_hal_ClearWarmStartInfo() */
+   MTA_HAL_REC_LINE_REGISTER_STATUS_CALLBACK_REGISTER=67,        /**< mta_hal_LineRegisterStatus_callback_register() */
+   MTA_HAL_REC_LINE_REGISTER_STATUS_SUBSCRIBE=68,                /**< mta_hal_LineRegisterStatus_subscribe() */
+   MTA_HAL_REC_LINE_REGISTER_STATUS_UNSUBSCRIBE=69,              /**< mta_hal_LineRegisterStatus_unsubscribe() */
+   MTA_HAL_REC_OPEN_EVENT_FD=70,                                 /**< mta_hal_OpenEventFd() */
+   MTA_HAL_REC_DRAIN_EVENTS=71,                                  /**< mta_hal_DrainEvents() */
+   MTA_HAL_REC_CLOSE_EVENT_FD=72,                                /**< mta_hal_CloseEventFd() */
+   MTA_HAL_REC_GET_CALL_QUALITY_THRESHOLDS=73,                   /**< mta_hal_GetCallQualityThresholds() */
+   MTA_HAL_REC_SET_CALL_QUALITY_THRESHOLDS=74,                   /**< mta_hal_SetCallQualityThresholds() */
+   MTA_HAL_REC_CALL_QUALITY_ALARM_SUBSCRIBE=75,                  /**< mta_hal_CallQualityAlarm_subscribe() */
+   MTA_HAL_REC_CALL_QUALITY_ALARM_UNSUBSCRIBE=76,                /**< mta_hal_CallQualityAlarm_unsubscribe() */
+   MTA_HAL_REC_GET_CALL_QUALITY_ALARMS=77,                       /**< mta_hal_GetCallQualityAlarms() */
+   MTA_HAL_REC_GET_DIAGNOSTICS_CONCURRENCY=78,                   /**< mta_hal_GetDiagnosticsConcurrency() */
+   MTA_HAL_REC_TRIGGER_DIAGNOSTICS_ASYNC=79,                     /**< mta_hal_TriggerDiagnosticsAsync() */
+   MTA_HAL_REC_CANCEL_DIAGNOSTICS=80,                            /**< mta_hal_CancelDiagnostics() */
+   MTA_HAL_REC_GET_LINE_COUNT=81,                                /**< mta_hal_getLineCount() */
+   MTA_HAL_REC_GET_LINE_REGISTER_STATUS_PACKED=82,               /**< mta_hal_getLineRegisterStatusPacked() */
+   MTA_HAL_REC_LINE_REGISTER_STATUS_PACKED_CALLBACK_REGISTER=83, /**< mta_hal_LineRegisterStatusPacked_callback_register() */
+   MTA_HAL_REC_GET_DHCP_INFO_WITH_TIMEOUT=84,                    /**< mta_hal_GetDHCPInfoWithTimeout() */
+   MTA_HAL_REC_GET_DHCPV6_INFO_WITH_TIMEOUT=85,                  /**< mta_hal_GetDHCPV6InfoWithTimeout() */
+   MTA_HAL_REC_LINETABLE_GET_ENTRY_WITH_TIMEOUT=86,              /**< mta_hal_LineTableGetEntryWithTimeout() */
+   MTA_HAL_REC_GET_SERVICE_FLOW_WITH_TIMEOUT=87,                 /**< mta_hal_GetServiceFlowWithTimeout() */
+   MTA_HAL_REC_GET_HANDSETS_WITH_TIMEOUT=88,                     /**< mta_hal_GetHandsetsWithTimeout() */
+   MTA_HAL_REC_GET_CALLS_WITH_TIMEOUT=89,                        /**< mta_hal_GetCallsWithTimeout() */
+   MTA_HAL_REC_GET_CALLP_WITH_TIMEOUT=90,                        /**< mta_hal_GetCALLPWithTimeout() */
+   MTA_HAL_REC_GET_DSX_LOGS_WITH_TIMEOUT=91,                     /**< mta_hal_GetDSXLogsWithTimeout() */
+   MTA_HAL_REC_GET_MTA_LOG_WITH_TIMEOUT=92,                      /**< mta_hal_GetMtaLogWithTimeout() */
+   MTA_HAL_REC_GET_MEMORY_USAGE=93,                              /**< mta_hal_GetMemoryUsage() */
+   MTA_HAL_REC_GET_RETENTION_LIMITS=94,                          /**< mta_hal_GetRetentionLimits() */
+   MTA_HAL_REC_SET_RETENTION_LIMITS=95,                          /**< mta_hal_SetRetentionLimits() */
+   MTA_HAL_REC_CB_LINE_REGISTER_STATUS=96,                       /**< mta_hal_getLineRegisterStatus_callback invocation */
+   MTA_HAL_REC_CB_LINE_REGISTER_STATUS_SUBSCRIBER=97,            /**< mta_hal_LineRegisterStatus_subscriber invocation */
+   MTA_HAL_REC_CB_CALL_QUALITY_ALARM=98,                         /**< mta_hal_CallQualityAlarm_subscriber invocation */
+   MTA_HAL_REC_CB_DIAGNOSTICS=99,                                /**< mta_hal_diagnostics_callback invocation */
+   MTA_HAL_REC_CB_LINE_REGISTER_STATUS_PACKED=100,               /**< mta_hal_LineRegisterStatusPacked_callback invocation */
+   MTA_HAL_REC_CB_EVENTS=101,                                    /**< MTA_EVENT_* bits becoming pending on a descriptor from mta_hal_OpenEventFd(); the bits are held in Index */
+   MTA_HAL_REC_BROKER_SET_CACHE_TTL=102,                         /**< mta_hal_broker_SetCacheTtl() */
+   MTA_HAL_REC_BROKER_GET_CACHE_TTL=103,                         /**< mta_hal_broker_GetCacheTtl() */
+   MTA_HAL_REC_BROKER_FLUSH_CACHE=104                            /**< mta_hal_broker_FlushCache() */
+} MTA_HAL_RECORD_API;
+
+#define MTA_HAL_RECORD_NULL        0xFFFFFFFF    /**< Encoded value of a NULL pointer member. */
+
+/**
+ * @brief Header at the start of every capture file.
+ *
+ * All multi-byte fields, here and in the entries and payloads, are stored in the byte order of the recording device, as identified by Magic.
+ */
+typedef struct _MTA_HAL_RECORD_FILE_HEADER
+{
+    uint32_t Magic;                  /**< MTA_HAL_RECORD_MAGIC. */
+    uint16_t Version;                /**< MTA_HAL_RECORD_VERSION. */
+    uint16_t HeaderSize;             /**< Size of this header in bytes, allowing later versions to extend it. */
+    uint64_t StartTimeUs;            /**< Wall clock time at which recording started, in microseconds since the epoch. */
+    CHAR     Target[64];             /**< Name of the recorded HAL library, for information only. */
+    uint8_t  UlongSize;              /**< sizeof(ULONG) on the recording device, for information only; payloads do not depend on it. */
+    uint8_t  PointerSize;            /**< sizeof(void *) on the recording device, for information only; payloads do not depend on it. */
+    uint16_t Reserved1;              /**< Reserved, must be 0. */
+    uint32_t Reserved2;              /**< Reserved, must be 0. */
+} MTA_HAL_RECORD_FILE_HEADER;
+
+/**
+ * @brief Header of one capture file entry, immediately followed by PayloadSize bytes of payload.
+ *
+ * Each call is recorded as one entry whose payload is the request followed by the response:
+ * - The request holds the input arguments of the call in declaration order. Callback pointers and pUserData are not recorded.
+ * - The response holds the output arguments in declaration order. It is empty when Status is not RETURN_OK.
+ * - A callback invocation records its arguments, except pUserData, as a response with an empty request.
+ *
+ * Arguments and structure members are encoded at a fixed width, independent of the compiler and word size, with no padding:
+ * - ULONG, INT, int and enumerations are 4 bytes. BOOLEAN, UCHAR and CHAR are 1 byte. uint64_t is 8 bytes.
+ * - ANSC_IPV4_ADDRESS is its 4 Dot bytes. struct in6_addr is its 16 bytes. Both are in network byte order.
+ * - Fixed-size arrays are encoded element by element at their declared length. Nested structures are encoded member by member.
+ * - A pointer argument to a single structure or value is encoded as the pointed-to structure or value.
+ * - An array argument, such as the array returned by mta_hal_GetCalls() or the pIndexes of mta_hal_TriggerDiagnosticsAsync(),
+ *   is encoded as a uint32_t element count followed by the elements. For buffers filled by the HAL the count is the number
+ *   of elements written.
+ * - A zero-terminated string argument is encoded as a uint32_t length followed by the characters, without the NUL.
+ * - A pointer member of a structure is encoded as a uint32_t byte offset, relative to the start of the request or response,
+ *   into a trailer appended after its arguments, or MTA_HAL_RECORD_NULL. The trailer holds:
+ *   - MTAMGMT_MTA_MTALOG_FULL.pDescription as a zero-terminated string;
+ *   - MTAMGMT_MTA_LOG_FILTER.pEventIDs as EventIDCount 4-byte values;
+ *   - MTAMGMT_MTA_LINETABLE_INFO.pCalls as a uint32_t count equal to CallsNumber, followed by that many MTAMGMT_MTA_CALLS records.
+ *   Any pointer member added to mta_hal.h must be given an encoding here.
+ *
+ * Index selects the data a call applies to, so that replay can tell e.g. the calls of line 1 from those of line 2.
+ * It is the first argument of the functions whose first argument is one of:
+ * - the line table Index, InstanceNumber or LineNumber of a line, e.g. mta_hal_LineTableGetEntry(), mta_hal_GetCalls(),
+ *   mta_hal_GetCALLP(), mta_hal_ClearCalls(), the call history and call quality threshold functions, and their WithTimeout variants;
+ * - the handset of mta_hal_DectDeregisterDectHandset();
+ * - the Mode of mta_hal_InitDBEx() or the Subsystem of mta_hal_InitSubsystem() and mta_hal_GetSubsystemStatus().
+ * For every other function, and for callback invocations, Index is 0. Timeouts, descriptors, subscription and request identifiers,
+ * masks and counts are never used as Index, as they differ from one run to the next without changing the data.
+ */
+typedef struct _MTA_HAL_RECORD_ENTRY
+{
+    uint16_t ApiId;                  /**< MTA_HAL_RECORD_API value. */
+    uint16_t Flags;                  /**< Reserved, must be 0. */
+    int32_t  Status;                 /**< Return value of the recorded call. */
+    uint64_t OffsetUs;               /**< Time at which the call was made, in microseconds since StartTimeUs. */
+    uint32_t DurationUs;             /**< Time taken by the real HAL to complete the call, in microseconds. */
+    uint32_t Index;                  /**< Line, handset, mode or subsystem selected by the call, as defined above. 0 when the call has none. */
+    uint32_t Count;                  /**< Element count of the array returned by the array APIs, as also encoded in the response. Otherwise 0. */
+    uint32_t RequestSize;            /**< Size of the request at the start of the payload, in bytes. */
+    uint32_t PayloadSize;            /**< Size of the payload following this header, in bytes: the request, then the response. */
+    uint32_t Reserved;               /**< Reserved, must be 0. */
+} MTA_HAL_RECORD_ENTRY;
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup MTA_HAL_APIS
+ * @{
+ */
+
+/**
+* @brief Start recording every HAL request and response to a capture file. Implemented by the recorder shim only.
+* @param[in] pPath - Zero-terminated path of the capture file. An existing file is truncated.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_record_start(const CHAR *pPath);
+
+/**
+* @brief Stop recording and flush the capture file. Implemented by the recorder shim only.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. recording was not started.
+*
+*/
+INT mta_hal_record_stop(void);
+
+/**
+* @brief Load a capture file into the replay backend. Implemented by the replay backend only.
+*        A call is answered from the entries with the same ApiId and Index, in recorded order, wrapping around when they are exhausted,
+*        so that e.g. mta_hal_LineTableGetEntry() for each index returns the entry recorded for that index. A call with no matching
+*        entry returns RETURN_ERR. Recorded callback invocations are delivered to the installed callbacks at their recorded offsets.
+*        Descriptors, subscription identifiers and diagnostics request identifiers are allocated by the replay backend itself;
+*        the recorded values are not returned.
+* @param[in] pPath - Zero-terminated path of the capture file.
+* @param[in] SpeedPercent - Replay timing as a percentage of the recorded DurationUs. 100 reproduces the recorded latency, 0 replies immediately.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. the file is missing or has an unsupported version.
+*
+*/
+INT mta_hal_replay_open(const CHAR *pPath, ULONG SpeedPercent);
+
+/**
+* @brief Release the capture file loaded by mta_hal_replay_open(). Implemented by the replay backend only.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_replay_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MTA_HAL_RECORD_H__ */
+/**
+ * @}
+ */
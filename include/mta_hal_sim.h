@@ -0,0 +1,152 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file mta_hal_sim.h
+* @brief Synthetic data generator interface of the MTA HAL test backend.
+*
+* The test backend (`libhal_mta_sim.so`) exports the complete `mta_hal.h` API and serves data produced by a seeded, scenario-driven
+* generator instead of hardware: large call histories, DSX and MTA logs, service flows and a DECT handset roster with registration churn.
+* The same scenario always produces the same data, so scale tests can assert the latency and memory ceilings defined below for
+* mta_hal_GetCalls(), mta_hal_GetMtaLog(), mta_hal_GetDSXLogs() and mta_hal_GetServiceFlow() as the data size grows.
+* A generated data set can also be written as a capture file and served by the replay backend of mta_hal_record.h.
+*/
+
+#ifndef __MTA_HAL_SIM_H__
+#define __MTA_HAL_SIM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mta_hal_record.h"
+
+/**
+ * @addtogroup MTA_HAL_TYPES
+ * @{
+ */
+
+/**
+ * @brief Structure describing the data set to generate.
+ *
+ * Counts are the steady state sizes reached once the scenario is loaded. Rates of 0 keep the data set static.
+ * History beyond a non-zero cap of mta_hal_SetRetentionLimits() is discarded as it is generated, as on a real device,
+ * so a scenario larger than the default caps needs them lifted first.
+ */
+typedef struct _MTA_HAL_SIM_SCENARIO
+{
+    ULONG Seed;                      /**< Seed of the generator. The same scenario and seed always produce the same data. */
+    ULONG Lines;                     /**< Number of voice lines. Returned by mta_hal_getLineCount(). */
+    ULONG CallsPerLine;              /**< Number of call records per line. */
+    ULONG DSXLogEntries;             /**< Number of DSX log entries. */
+    ULONG MtaLogEntries;             /**< Number of MTA log entries. */
+    ULONG MtaLogDescriptionLen;      /**< Length of each MTA log description, in bytes, excluding the terminating NUL. */
+    ULONG ServiceFlows;              /**< Number of service flows. */
+    ULONG Handsets;                  /**< Number of registered DECT handsets. The value ranges from 0 to DECT_MAX_HANDSETS. */
+    ULONG CallsPerSecond;            /**< Rate at which new calls are added, across all lines. */
+    ULONG LogEntriesPerSecond;       /**< Rate at which new DSX and MTA log entries are added. */
+    ULONG HandsetChurnPerSecond;     /**< Rate of handset deregistrations and registrations, and of line register status changes. */
+    ULONG LatencyUs;                 /**< Simulated vendor latency added to every call, in microseconds. */
+} MTA_HAL_SIM_SCENARIO, *PMTA_HAL_SIM_SCENARIO;
+
+/*
+ * Scale ceilings.
+ * A scale test first lifts the retention caps by setting every MTAMGMT_MTA_RETENTION_LIMITS field to 0 with mta_hal_SetRetentionLimits(),
+ * then loads a scenario with LatencyUs and all rates set to 0 and MtaLogDescriptionLen set to 64, and calls each API 20 times.
+ * It is run at each data size n below, where n is the number of records the call returns, i.e. CallsPerLine, DSXLogEntries,
+ * MtaLogEntries or ServiceFlows:
+ *   mta_hal_GetCalls()        n = 10, 100, 1000, 10000
+ *   mta_hal_GetDSXLogs()      n = 100, 1000, 10000, 50000
+ *   mta_hal_GetMtaLog()       n = 100, 1000, 10000, 50000
+ *   mta_hal_GetServiceFlow()  n = 16, 64, 256
+ * Latency is the 95th percentile of the wall clock time of the 20 calls, and must not exceed the MTA_HAL_SIM_MAX_*_US ceiling for n.
+ * Memory is measured per call: mta_hal_sim_ResetPeakMemoryUsage() is called before it, and the rise of
+ * MTAMGMT_MTA_MEMORY_USAGE.PeakTotalBytes after it over TotalBytes before it must not exceed MTA_HAL_SIM_MAX_OVERHEAD_BYTES() of the size
+ * of the returned array. The returned array itself is not counted, as it is handed to the caller. TotalBytes must be back to its
+ * previous value after each call.
+ */
+#define MTA_HAL_SIM_MAX_GET_CALLS_US(n)         (2000 + 5 * (n))     /**< Latency ceiling of mta_hal_GetCalls() returning n calls, in microseconds. */
+#define MTA_HAL_SIM_MAX_GET_DSX_LOGS_US(n)      (2000 + 2 * (n))     /**< Latency ceiling of mta_hal_GetDSXLogs() returning n entries, in microseconds. */
+#define MTA_HAL_SIM_MAX_GET_MTA_LOG_US(n)       (2000 + 3 * (n))     /**< Latency ceiling of mta_hal_GetMtaLog() returning n entries, in microseconds. */
+#define MTA_HAL_SIM_MAX_GET_SERVICE_FLOW_US(n)  (2000 + 5 * (n))     /**< Latency ceiling of mta_hal_GetServiceFlow() returning n flows, in microseconds. */
+#define MTA_HAL_SIM_MAX_OVERHEAD_BYTES(bytes)   ((bytes) / 4 + 65536)  /**< Memory ceiling of a call returning an array of the given size, in bytes, descriptions included. */
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup MTA_HAL_APIS
+ * @{
+ */
+
+/**
+* @brief Replace the data served by the test backend with the data set generated from a scenario.
+*        Generation is done before returning, so subsequent calls measure retrieval only.
+* @param[in] pScenario - Scenario to generate.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. Handsets exceeds DECT_MAX_HANDSETS or the data set does not fit in memory.
+*
+*/
+INT mta_hal_sim_LoadScenario(const MTA_HAL_SIM_SCENARIO *pScenario);
+
+/**
+* @brief Write the data set generated from a scenario as a capture file, in the format of mta_hal_record.h.
+* @param[in] pScenario - Scenario to generate.
+* @param[in] pPath - Zero-terminated path of the capture file. An existing file is truncated.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_sim_WriteCapture(const MTA_HAL_SIM_SCENARIO *pScenario, const CHAR *pPath);
+
+/**
+* @brief Advance the rates of the loaded scenario by the given time, without waiting, e.g. to age call history deterministically.
+* @param[in] Ms - Simulated time to advance, in milliseconds.
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected, e.g. no scenario is loaded.
+*
+*/
+INT mta_hal_sim_Advance(ULONG Ms);
+
+/**
+* @brief Set MTAMGMT_MTA_MEMORY_USAGE.PeakTotalBytes to the current TotalBytes, so that the peak of a single call can be measured.
+*        Only the test backend provides this; on a device the peak covers the whole time since mta_hal_InitDB().
+*
+* @return The status of the operation.
+* @retval RETURN_OK if successful.
+* @retval RETURN_ERR if any error is detected
+*
+*/
+INT mta_hal_sim_ResetPeakMemoryUsage(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MTA_HAL_SIM_H__ */
+/**
+ * @}
+ */
@@ -0,0 +1,333 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file stub_mta_hal_history.hpp
+* @brief Stub HAL retaining call and log history under the caps of mta_hal_SetRetentionLimits(), and a service flow table.
+*
+* The stub accounts the bytes of the records it holds, MTA log descriptions included, and reports them through
+* mta_hal_GetMemoryUsage(). It is included by exactly one test of a test binary, which feeds it through stub::history().
+*/
+
+#ifndef __STUB_MTA_HAL_HISTORY_HPP__
+#define __STUB_MTA_HAL_HISTORY_HPP__
+
+extern "C" {
+#include "mta_hal.h"
+}
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stub
+{
+
+template <typename T>
+struct Entry
+{
+    unsigned long long seq;
+    T record;
+};
+
+struct MtaLogEntry
+{
+    MTAMGMT_MTA_MTALOG_FULL log;
+    std::string description;
+};
+
+class History
+{
+public:
+    /* Equivalent of mta_hal_InitDB() on a device with the given number of lines. */
+    void init(ULONG lines)
+    {
+        clear(lines);
+        limits_.MaxCallsPerLine = MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE;
+        limits_.MaxDSXLogEntries = MTA_HAL_DEFAULT_MAX_DSXLOG_ENTRIES;
+        limits_.MaxMtaLogEntries = MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES;
+        limits_.MaxTotalBytes = MTA_HAL_MEMORY_BUDGET(lines);
+        peak_ = 0;
+        account();
+    }
+
+    /* Drop all data and set the number of lines, keeping the retention caps. */
+    void clear(ULONG lines)
+    {
+        lines_ = lines;
+        calls_.assign(lines, {});
+        dsx_.clear();
+        mtaLog_.clear();
+        flows_.clear();
+        callsBytes_ = 0;
+        logsBytes_ = 0;
+        seq_ = 0;
+    }
+
+    ULONG lines() const { return lines_; }
+
+    void add_call(ULONG line, const MTAMGMT_MTA_CALLS &call)
+    {
+        calls_.at(line - 1).push_back({seq_++, call});
+        callsBytes_ += sizeof(MTAMGMT_MTA_CALLS);
+        trim();
+    }
+
+    void add_dsx_log(const MTAMGMT_MTA_DSXLOG &log)
+    {
+        dsx_.push_back({seq_++, log});
+        logsBytes_ += sizeof(MTAMGMT_MTA_DSXLOG);
+        trim();
+    }
+
+    void add_mta_log(const MTAMGMT_MTA_MTALOG_FULL &log, const std::string &description)
+    {
+        mtaLog_.push_back({seq_++, {log, description}});
+        mtaLog_.back().record.log.pDescription = NULL;
+        logsBytes_ += mta_log_bytes(mtaLog_.back());
+        trim();
+    }
+
+    void set_service_flows(std::vector<MTAMGMT_MTA_SERVICE_FLOW> flows)
+    {
+        flows_ = std::move(flows);
+        account();
+    }
+
+    /* Start a new peak from the current use, as mta_hal_sim_ResetPeakMemoryUsage() does. */
+    void reset_peak()
+    {
+        peak_ = total_bytes();
+    }
+
+    const std::deque<Entry<MTAMGMT_MTA_CALLS>> &calls(ULONG line) const { return calls_.at(line - 1); }
+    const std::deque<Entry<MTAMGMT_MTA_DSXLOG>> &dsx_logs() const { return dsx_; }
+    const std::deque<Entry<MtaLogEntry>> &mta_log() const { return mtaLog_; }
+    const std::vector<MTAMGMT_MTA_SERVICE_FLOW> &service_flows() const { return flows_; }
+
+    const MTAMGMT_MTA_RETENTION_LIMITS &limits() const { return limits_; }
+
+    void set_limits(const MTAMGMT_MTA_RETENTION_LIMITS &limits)
+    {
+        limits_ = limits;
+        trim();
+    }
+
+    void usage(MTAMGMT_MTA_MEMORY_USAGE &usage) const
+    {
+        std::memset(&usage, 0, sizeof(usage));
+        usage.CallsBytes = callsBytes_;
+        usage.LogsBytes = logsBytes_;
+        usage.FlowsBytes = flows_bytes();
+        usage.TotalBytes = total_bytes();
+        usage.PeakTotalBytes = peak_;
+        usage.AllocationCount = 0;
+        for (const auto &line : calls_)
+            usage.AllocationCount += line.size();
+        usage.AllocationCount += dsx_.size() + 2 * mtaLog_.size() + (flows_.empty() ? 0 : 1);
+    }
+
+private:
+    static ULONG mta_log_bytes(const Entry<MtaLogEntry> &entry)
+    {
+        return sizeof(MTAMGMT_MTA_MTALOG_FULL) + entry.record.description.size() + 1;
+    }
+
+    ULONG flows_bytes() const { return flows_.size() * sizeof(MTAMGMT_MTA_SERVICE_FLOW); }
+    ULONG total_bytes() const { return callsBytes_ + logsBytes_ + flows_bytes(); }
+
+    void account()
+    {
+        peak_ = std::max(peak_, total_bytes());
+    }
+
+    void pop_call(std::deque<Entry<MTAMGMT_MTA_CALLS>> &line)
+    {
+        line.pop_front();
+        callsBytes_ -= sizeof(MTAMGMT_MTA_CALLS);
+    }
+
+    void pop_dsx_log()
+    {
+        dsx_.pop_front();
+        logsBytes_ -= sizeof(MTAMGMT_MTA_DSXLOG);
+    }
+
+    void pop_mta_log()
+    {
+        logsBytes_ -= mta_log_bytes(mtaLog_.front());
+        mtaLog_.pop_front();
+    }
+
+    /* Discard the oldest record of any store, as MaxTotalBytes requires. */
+    bool discard_oldest()
+    {
+        unsigned long long oldest = ~0ULL;
+        std::deque<Entry<MTAMGMT_MTA_CALLS>> *oldestLine = nullptr;
+        bool dsx = false;
+        bool mtaLog = false;
+        for (auto &line : calls_)
+        {
+            if (!line.empty() && line.front().seq < oldest)
+            {
+                oldest = line.front().seq;
+                oldestLine = &line;
+            }
+        }
+        if (!dsx_.empty() && dsx_.front().seq < oldest)
+        {
+            oldest = dsx_.front().seq;
+            dsx = true;
+        }
+        if (!mtaLog_.empty() && mtaLog_.front().seq < oldest)
+        {
+            oldest = mtaLog_.front().seq;
+            mtaLog = true;
+        }
+        if (mtaLog)
+            pop_mta_log();
+        else if (dsx)
+            pop_dsx_log();
+        else if (oldestLine)
+            pop_call(*oldestLine);
+        else
+            return false;
+        return true;
+    }
+
+    void trim()
+    {
+        for (auto &line : calls_)
+            while (limits_.MaxCallsPerLine && line.size() > limits_.MaxCallsPerLine)
+                pop_call(line);
+        while (limits_.MaxDSXLogEntries && dsx_.size() > limits_.MaxDSXLogEntries)
+            pop_dsx_log();
+        while (limits_.MaxMtaLogEntries && mtaLog_.size() > limits_.MaxMtaLogEntries)
+            pop_mta_log();
+        while (limits_.MaxTotalBytes && total_bytes() > limits_.MaxTotalBytes)
+            if (!discard_oldest())
+                break;
+        account();
+    }
+
+    ULONG lines_ = 0;
+    std::vector<std::deque<Entry<MTAMGMT_MTA_CALLS>>> calls_;
+    std::deque<Entry<MTAMGMT_MTA_DSXLOG>> dsx_;
+    std::deque<Entry<MtaLogEntry>> mtaLog_;
+    std::vector<MTAMGMT_MTA_SERVICE_FLOW> flows_;
+    ULONG callsBytes_ = 0;
+    ULONG logsBytes_ = 0;
+    unsigned long long seq_ = 0;
+    MTAMGMT_MTA_RETENTION_LIMITS limits_{};
+    ULONG peak_ = 0;
+};
+
+inline History &history()
+{
+    static History h;
+    return h;
+}
+
+template <typename T, typename Store, typename Copy>
+INT copy_out(const Store &store, ULONG *Count, T **pp, Copy copy)
+{
+    if (!Count || !pp)
+        return RETURN_ERR;
+    *Count = store.size();
+    *pp = static_cast<T *>(std::calloc(store.size() ? store.size() : 1, sizeof(T)));
+    if (!*pp)
+        return RETURN_ERR;
+    ULONG i = 0;
+    for (const auto &entry : store)
+        copy((*pp)[i++], entry.record);
+    return RETURN_OK;
+}
+
+} // namespace stub
+
+extern "C" ULONG mta_hal_LineTableGetNumberOfEntries(void)
+{
+    return stub::history().lines();
+}
+
+extern "C" INT mta_hal_GetCalls(ULONG InstanceNumber, ULONG *Count, PMTAMGMT_MTA_CALLS *ppCfg)
+{
+    if (InstanceNumber < 1 || InstanceNumber > stub::history().lines())
+        return RETURN_ERR;
+    return stub::copy_out(stub::history().calls(InstanceNumber), Count, ppCfg,
+                          [](MTAMGMT_MTA_CALLS &out, const MTAMGMT_MTA_CALLS &in) { out = in; });
+}
+
+extern "C" INT mta_hal_GetDSXLogs(ULONG *Count, PMTAMGMT_MTA_DSXLOG *ppDSXLog)
+{
+    return stub::copy_out(stub::history().dsx_logs(), Count, ppDSXLog,
+                          [](MTAMGMT_MTA_DSXLOG &out, const MTAMGMT_MTA_DSXLOG &in) { out = in; });
+}
+
+extern "C" INT mta_hal_GetMtaLog(ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL *ppCfg)
+{
+    return stub::copy_out(stub::history().mta_log(), Count, ppCfg,
+                          [](MTAMGMT_MTA_MTALOG_FULL &out, const stub::MtaLogEntry &in) {
+                              out = in.log;
+                              out.pDescription = strdup(in.description.c_str());
+                          });
+}
+
+extern "C" INT mta_hal_GetServiceFlow(ULONG *Count, PMTAMGMT_MTA_SERVICE_FLOW *ppCfg)
+{
+    if (!Count || !ppCfg)
+        return RETURN_ERR;
+    const auto &flows = stub::history().service_flows();
+    *Count = flows.size();
+    *ppCfg = static_cast<PMTAMGMT_MTA_SERVICE_FLOW>(std::calloc(flows.size() ? flows.size() : 1, sizeof(MTAMGMT_MTA_SERVICE_FLOW)));
+    if (!*ppCfg)
+        return RETURN_ERR;
+    std::copy(flows.begin(), flows.end(), *ppCfg);
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_GetMemoryUsage(PMTAMGMT_MTA_MEMORY_USAGE pUsage)
+{
+    if (!pUsage)
+        return RETURN_ERR;
+    stub::history().usage(*pUsage);
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_GetRetentionLimits(PMTAMGMT_MTA_RETENTION_LIMITS pLimits)
+{
+    if (!pLimits)
+        return RETURN_ERR;
+    *pLimits = stub::history().limits();
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_SetRetentionLimits(PMTAMGMT_MTA_RETENTION_LIMITS pLimits)
+{
+    if (!pLimits)
+        return RETURN_ERR;
+    stub::history().set_limits(*pLimits);
+    return RETURN_OK;
+}
+
+#endif /* __STUB_MTA_HAL_HISTORY_HPP__ */
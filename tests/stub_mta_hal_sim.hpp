@@ -0,0 +1,93 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file stub_mta_hal_sim.hpp
+* @brief Stub of the test backend of mta_hal_sim.h, generating its data into the history stub.
+*
+* Only static scenarios are served: the rates and LatencyUs must be 0, and handsets are validated but not generated.
+*/
+
+#ifndef __STUB_MTA_HAL_SIM_HPP__
+#define __STUB_MTA_HAL_SIM_HPP__
+
+#include "stub_mta_hal_history.hpp"
+#include "mta_hal_sim.h"
+
+#include <cstdio>
+#include <random>
+
+extern "C" INT mta_hal_sim_LoadScenario(const MTA_HAL_SIM_SCENARIO *pScenario)
+{
+    if (!pScenario || pScenario->Lines == 0 || pScenario->Handsets > DECT_MAX_HANDSETS)
+        return RETURN_ERR;
+    if (pScenario->CallsPerSecond || pScenario->LogEntriesPerSecond || pScenario->HandsetChurnPerSecond || pScenario->LatencyUs)
+        return RETURN_ERR;
+
+    auto &h = stub::history();
+    std::minstd_rand rng(pScenario->Seed);
+    h.clear(pScenario->Lines);
+
+    MTAMGMT_MTA_CALLS call{};
+    for (ULONG i = 0; i < pScenario->CallsPerLine; i++)
+    {
+        for (ULONG line = 1; line <= pScenario->Lines; line++)
+        {
+            std::snprintf(call.Codec, sizeof(call.Codec), "G.711");
+            std::snprintf(call.CallStartTime, sizeof(call.CallStartTime), "%lu", i * 60);
+            call.CallDuration = rng() % 60;
+            h.add_call(line, call);
+        }
+    }
+
+    MTAMGMT_MTA_DSXLOG dsx{};
+    for (ULONG i = 0; i < pScenario->DSXLogEntries; i++)
+    {
+        std::snprintf(dsx.Description, sizeof(dsx.Description), "DSA-REQ %lu", static_cast<ULONG>(rng()));
+        dsx.ID = i;
+        dsx.Level = rng() % 8;
+        h.add_dsx_log(dsx);
+    }
+
+    MTAMGMT_MTA_MTALOG_FULL log{};
+    for (ULONG i = 0; i < pScenario->MtaLogEntries; i++)
+    {
+        log.Index = i;
+        log.EventID = rng() % 1000;
+        h.add_mta_log(log, std::string(pScenario->MtaLogDescriptionLen, static_cast<char>('a' + rng() % 26)));
+    }
+
+    std::vector<MTAMGMT_MTA_SERVICE_FLOW> flows(pScenario->ServiceFlows);
+    for (ULONG i = 0; i < pScenario->ServiceFlows; i++)
+    {
+        flows[i].SFID = i + 1;
+        std::snprintf(flows[i].Direction, sizeof(flows[i].Direction), "%s", i % 2 ? "Upstream" : "Downstream");
+        flows[i].MaxTrafficRate = rng() % 100000;
+    }
+    h.set_service_flows(std::move(flows));
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_sim_ResetPeakMemoryUsage(void)
+{
+    stub::history().reset_peak();
+    return RETURN_OK;
+}
+
+#endif /* __STUB_MTA_HAL_SIM_HPP__ */
@@ -0,0 +1,382 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file test_mta_hal_async.cpp
+* @brief Tests of the mta_hal_async.hpp executor against a stub HAL.
+*
+* The stub HAL can be held at a gate, so that requests are queued behind a running call in a known order.
+*/
+
+#include "mta_hal_async.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/* Stub HAL */
+
+class Gate
+{
+public:
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = false;
+        entered_ = false;
+    }
+
+    void open()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    /* Block the calling HAL function until the gate is opened. */
+    void pass()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_ = true;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return open_; });
+    }
+
+    /* Wait until a HAL function is held at the gate. */
+    void wait_entered()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return entered_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = true;
+    bool entered_ = false;
+};
+
+static Gate gate;
+static std::atomic<int> dhcpCalls{0};
+static std::atomic<int> callsCalls{0};
+
+extern "C" INT mta_hal_GetDHCPInfo(PMTAMGMT_MTA_DHCP_INFO pInfo)
+{
+    dhcpCalls++;
+    gate.pass();
+    std::memset(pInfo, 0, sizeof(*pInfo));
+    std::strcpy(pInfo->FQDN, "mta.example");
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_GetCalls(ULONG, ULONG *Count, PMTAMGMT_MTA_CALLS *ppCfg)
+{
+    callsCalls++;
+    gate.pass();
+    *Count = 4;
+    *ppCfg = static_cast<PMTAMGMT_MTA_CALLS>(std::calloc(4, sizeof(MTAMGMT_MTA_CALLS)));
+    return RETURN_OK;
+}
+
+/* Minimal eager coroutine, completed through a std::promise. */
+
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::abort(); }
+    };
+};
+
+static Task await_calls(mta_hal::Executor &ex, std::promise<std::size_t> &done, std::thread::id &resumedOn)
+{
+    auto result = co_await ex.get_calls(1);
+    resumedOn = std::this_thread::get_id();
+    done.set_value(*result ? (*result)->size() : 0);
+}
+
+static Task await_dhcp_lvalue(mta_hal::Executor &ex, std::promise<std::string> &done)
+{
+    auto pending = ex.get_dhcp_info();
+    const auto &result = co_await pending;
+    done.set_value(result ? std::string(mta_hal::field(result->FQDN)) : std::string());
+}
+
+static Task await_cancelled_dhcp(mta_hal::Executor &ex, std::promise<mta_hal::Error> &done)
+{
+    auto pending = ex.get_dhcp_info();
+    pending.cancel();
+    const auto &result = co_await pending;
+    done.set_value(result.error());
+}
+
+/* Tests */
+
+static void test_coalescing()
+{
+    mta_hal::Executor ex;
+    gate.close();
+    dhcpCalls = 0;
+    callsCalls = 0;
+    auto first = ex.get_dhcp_info();
+    gate.wait_entered();
+    /* Queued behind the running call: both join one request and share its result. */
+    auto second = ex.get_calls(1);
+    auto third = ex.get_calls(1);
+    /* A different key is a different request. */
+    auto other = ex.get_calls(2);
+    gate.open();
+    CHECK(first.get());
+    CHECK(second.get() && third.get() && other.get());
+    CHECK(&second.get() == &third.get());
+    CHECK(&second.get() != &other.get());
+    CHECK(callsCalls == 2);
+    CHECK(dhcpCalls == 1);
+}
+
+static void test_coalescing_count()
+{
+    mta_hal::Executor ex;
+    gate.close();
+    callsCalls = 0;
+    dhcpCalls = 0;
+    auto blocker = ex.get_calls(2);
+    gate.wait_entered();
+    std::vector<mta_hal::Pending<MTAMGMT_MTA_DHCP_INFO>> requests;
+    for (int i = 0; i < 10; i++)
+        requests.push_back(ex.get_dhcp_info());
+    gate.open();
+    for (auto &r : requests)
+        CHECK(r.get() && mta_hal::field(r.get()->FQDN) == "mta.example");
+    CHECK(dhcpCalls == 1);
+}
+
+static void test_cancel()
+{
+    mta_hal::Executor ex;
+    gate.close();
+    callsCalls = 0;
+    dhcpCalls = 0;
+    auto blocker = ex.get_calls(1);
+    gate.wait_entered();
+    auto cancelled = ex.get_dhcp_info();
+    cancelled.cancel();
+    gate.open();
+    CHECK(cancelled.get().error() == mta_hal::Error::Cancelled);
+    CHECK(dhcpCalls == 0);
+    CHECK(blocker.get());
+}
+
+/*
+ * A request submitted while a cancelled job is being abandoned must not join it.
+ * The scheduler blocks the worker inside the abandon, holding the window open for the new request.
+ */
+static void test_no_join_while_abandoning()
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool entered = false;
+    bool released = false;
+    std::coroutine_handle<> posted;
+    std::promise<mta_hal::Error> done;
+    auto future = done.get_future();
+    mta_hal::Executor ex(1, 32, [&](std::coroutine_handle<> h) {
+        std::unique_lock<std::mutex> lock(mutex);
+        posted = h;
+        entered = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return released; });
+    });
+
+    gate.close();
+    dhcpCalls = 0;
+    auto blocker = ex.get_calls(1);
+    gate.wait_entered();
+    await_cancelled_dhcp(ex, done);
+    gate.open();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return entered; });
+    }
+
+    auto fresh = ex.get_dhcp_info();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    cv.notify_all();
+
+    CHECK(fresh.get());
+    CHECK(dhcpCalls == 1);
+    posted.resume();
+    CHECK(future.get() == mta_hal::Error::Cancelled);
+}
+
+static void test_move_assign_cancels()
+{
+    mta_hal::Executor ex;
+    gate.close();
+    dhcpCalls = 0;
+    auto blocker = ex.get_calls(1);
+    gate.wait_entered();
+    auto pending = ex.submit<int>("", [] { return mta_hal::Result<int>(mta_hal::get_dhcp_info() ? 1 : 0); });
+    auto future = pending.future();
+    pending = ex.submit<int>("", [] { return mta_hal::Result<int>(7); });
+    gate.open();
+    CHECK(future.get()->error() == mta_hal::Error::Cancelled);
+    CHECK(pending.get() && *pending.get() == 7);
+    CHECK(dhcpCalls == 0);
+}
+
+static void test_busy()
+{
+    mta_hal::Executor ex(1, 1);
+    gate.close();
+    auto blocker = ex.get_calls(1);
+    gate.wait_entered();
+    auto queued = ex.get_dhcp_info();
+    auto rejected = ex.submit<int>("", [] { return mta_hal::Result<int>(1); });
+    CHECK(rejected.ready());
+    CHECK(rejected.get().error() == mta_hal::Error::Busy);
+    gate.open();
+}
+
+static void test_exception()
+{
+    mta_hal::Executor ex;
+    auto failing = ex.submit<int>("", []() -> mta_hal::Result<int> { throw std::runtime_error("hal"); });
+    bool thrown = false;
+    try
+    {
+        (void)failing.get();
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    /* The worker survives the exception. */
+    auto next = ex.submit<int>("", [] { return mta_hal::Result<int>(3); });
+    CHECK(next.get() && *next.get() == 3);
+}
+
+static void test_temporary_get_owns_result()
+{
+    mta_hal::Executor ex;
+    gate.open();
+    auto result = ex.get_calls(1).get();
+    CHECK(result && *result);
+    CHECK((*result)->size() == 4);
+}
+
+static void test_co_await_completion_thread()
+{
+    std::promise<std::size_t> done;
+    auto future = done.get_future();
+    std::thread::id resumedOn;
+    {
+        mta_hal::Executor ex;
+        gate.close();
+        await_calls(ex, done, resumedOn);
+        gate.wait_entered();
+        gate.open();
+        CHECK(future.get() == 4);
+    }
+    CHECK(resumedOn != std::this_thread::get_id());
+}
+
+static void test_co_await_scheduler()
+{
+    std::mutex mutex;
+    std::deque<std::coroutine_handle<>> posted;
+    mta_hal::Executor ex(1, 32, [&](std::coroutine_handle<> h) {
+        std::lock_guard<std::mutex> lock(mutex);
+        posted.push_back(h);
+    });
+    std::promise<std::string> done;
+    auto future = done.get_future();
+    gate.close();
+    await_dhcp_lvalue(ex, done);
+    gate.wait_entered();
+    gate.open();
+
+    /* Run the posted continuation on this thread, as an event loop would. */
+    for (;;)
+    {
+        std::coroutine_handle<> h;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!posted.empty())
+            {
+                h = posted.front();
+                posted.pop_front();
+            }
+        }
+        if (h)
+        {
+            h.resume();
+            break;
+        }
+        std::this_thread::yield();
+    }
+    CHECK(future.get() == "mta.example");
+}
+
+int main()
+{
+    test_coalescing();
+    test_coalescing_count();
+    test_cancel();
+    test_no_join_while_abandoning();
+    test_move_assign_cancels();
+    test_busy();
+    test_exception();
+    test_temporary_get_owns_result();
+    test_co_await_completion_thread();
+    test_co_await_scheduler();
+
+    if (failures)
+    {
+        std::fprintf(stderr, "test_mta_hal_async: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("test_mta_hal_async: passed\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file test_mta_hal_budget.cpp
+* @brief Tests of the memory budget and retention caps of mta_hal.h against a stub HAL holding full history.
+*
+* The history is filled past every default cap, so the retained records are exactly those the caps allow.
+*/
+
+#include "stub_mta_hal_history.hpp"
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/* MTA log descriptions are assumed to be at most this long, excluding the terminating NUL. */
+static const std::size_t descriptionLen = 255;
+
+static void fill(ULONG callsPerLine, ULONG logEntries)
+{
+    auto &h = stub::history();
+    MTAMGMT_MTA_CALLS call{};
+    for (ULONG i = 0; i < callsPerLine; i++)
+    {
+        for (ULONG line = 1; line <= h.lines(); line++)
+        {
+            std::snprintf(call.Codec, sizeof(call.Codec), "%lu", i);
+            h.add_call(line, call);
+        }
+    }
+    MTAMGMT_MTA_DSXLOG dsx{};
+    MTAMGMT_MTA_MTALOG_FULL log{};
+    for (ULONG i = 0; i < logEntries; i++)
+    {
+        dsx.ID = i;
+        h.add_dsx_log(dsx);
+        log.Index = i;
+        h.add_mta_log(log, std::string(descriptionLen, 'd'));
+    }
+}
+
+static void test_default_budget()
+{
+    CHECK(MTA_HAL_MEMORY_BUDGET_BYTES == 2097152);
+    CHECK(MTA_HAL_MEMORY_BUDGET(0) == MTA_HAL_MEMORY_BUDGET_BASE_BYTES);
+}
+
+/* With the default caps full, the HAL stays within the budget of its line count, and the budget trims nothing. */
+static void test_default_caps_fit(ULONG lines)
+{
+    auto &h = stub::history();
+    h.init(lines);
+    MTAMGMT_MTA_RETENTION_LIMITS limits;
+    CHECK(mta_hal_GetRetentionLimits(&limits) == RETURN_OK);
+    CHECK(limits.MaxTotalBytes == MTA_HAL_MEMORY_BUDGET(lines));
+
+    fill(2 * MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE, 2 * MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES);
+    for (ULONG line = 1; line <= lines; line++)
+        CHECK(h.calls(line).size() == MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE);
+    CHECK(h.dsx_logs().size() == MTA_HAL_DEFAULT_MAX_DSXLOG_ENTRIES);
+    CHECK(h.mta_log().size() == MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES);
+
+    MTAMGMT_MTA_MEMORY_USAGE usage;
+    CHECK(mta_hal_GetMemoryUsage(&usage) == RETURN_OK);
+    CHECK(usage.TotalBytes <= MTA_HAL_MEMORY_BUDGET(lines));
+    CHECK(usage.PeakTotalBytes <= MTA_HAL_MEMORY_BUDGET(lines));
+}
+
+/* Below the default budget, MaxTotalBytes wins over the count caps and the oldest records go first. */
+static void test_total_bytes_wins()
+{
+    auto &h = stub::history();
+    h.init(MTA_LINENUMBER);
+    fill(MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE, MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES);
+
+    MTAMGMT_MTA_RETENTION_LIMITS limits;
+    CHECK(mta_hal_GetRetentionLimits(&limits) == RETURN_OK);
+    limits.MaxTotalBytes = MTA_HAL_MEMORY_BUDGET_BYTES / 2;
+    CHECK(mta_hal_SetRetentionLimits(&limits) == RETURN_OK);
+
+    MTAMGMT_MTA_MEMORY_USAGE usage;
+    CHECK(mta_hal_GetMemoryUsage(&usage) == RETURN_OK);
+    CHECK(usage.TotalBytes <= limits.MaxTotalBytes);
+
+    /* Calls were added first, so they are trimmed before any log entry. */
+    CHECK(h.calls(1).size() < MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE);
+    CHECK(h.mta_log().size() == MTA_HAL_DEFAULT_MAX_MTALOG_ENTRIES);
+
+    ULONG count = 0;
+    PMTAMGMT_MTA_CALLS calls = NULL;
+    CHECK(mta_hal_GetCalls(MTA_LINENUMBER, &count, &calls) == RETURN_OK);
+    CHECK(count == h.calls(MTA_LINENUMBER).size());
+    if (count)
+        CHECK(std::string(calls[count - 1].Codec) == std::to_string(MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE - 1));
+    free(calls);
+}
+
+int main()
+{
+    test_default_budget();
+    for (ULONG lines : {1UL, 2UL, 8UL, 16UL, 32UL})
+        test_default_caps_fit(lines);
+    test_total_bytes_wins();
+
+    if (failures)
+    {
+        std::fprintf(stderr, "test_mta_hal_budget: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("test_mta_hal_budget: passed\n");
+    return 0;
+}
@@ -0,0 +1,269 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file test_mta_hal_hpp.cpp
+* @brief Tests of the mta_hal.hpp facade against a stub HAL.
+*
+* The stub allocates exactly as mta_hal.h requires, so a missing or wrong free is reported by the address sanitizer.
+*/
+
+#include "mta_hal.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/* Stub HAL */
+
+static INT stubStatus = RETURN_OK;
+static ULONG stubCount = 0;
+static ULONG stubTimeoutMs = 0;
+
+extern "C" INT mta_hal_GetMtaLog(ULONG *Count, PMTAMGMT_MTA_MTALOG_FULL *ppCfg)
+{
+    if (stubStatus != RETURN_OK)
+        return stubStatus;
+    *Count = stubCount;
+    *ppCfg = static_cast<PMTAMGMT_MTA_MTALOG_FULL>(std::calloc(stubCount, sizeof(MTAMGMT_MTA_MTALOG_FULL)));
+    for (ULONG i = 0; i < stubCount; i++)
+    {
+        std::snprintf((*ppCfg)[i].EventLevel, sizeof((*ppCfg)[i].EventLevel), "%lu", i);
+        (*ppCfg)[i].pDescription = i % 2 ? NULL : strdup("description");
+    }
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_GetCalls(ULONG InstanceNumber, ULONG *Count, PMTAMGMT_MTA_CALLS *ppCfg)
+{
+    if (stubStatus != RETURN_OK)
+        return stubStatus;
+    *Count = stubCount;
+    *ppCfg = static_cast<PMTAMGMT_MTA_CALLS>(std::calloc(stubCount, sizeof(MTAMGMT_MTA_CALLS)));
+    for (ULONG i = 0; i < stubCount; i++)
+        std::snprintf((*ppCfg)[i].Codec, sizeof((*ppCfg)[i].Codec), "line%lu", InstanceNumber);
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_GetCallsWithTimeout(ULONG, ULONG *, PMTAMGMT_MTA_CALLS *, ULONG TimeoutMs)
+{
+    stubTimeoutMs = TimeoutMs;
+    return TimeoutMs < 10 ? RETURN_TIMEOUT : RETURN_ERR;
+}
+
+extern "C" INT mta_hal_GetDHCPInfo(PMTAMGMT_MTA_DHCP_INFO pInfo)
+{
+    if (stubStatus != RETURN_OK)
+        return stubStatus;
+    std::memset(pInfo->FQDN, 'x', sizeof(pInfo->FQDN));
+    return RETURN_OK;
+}
+
+extern "C" INT mta_hal_LineTableGetEntry(ULONG Index, PMTAMGMT_MTA_LINETABLE_INFO pEntry)
+{
+    if (stubStatus != RETURN_OK)
+        return stubStatus;
+    std::memset(pEntry, 0, sizeof(*pEntry));
+    pEntry->InstanceNumber = Index + 1;
+    pEntry->CallsNumber = stubCount;
+    pEntry->pCalls = stubCount ? static_cast<PMTAMGMT_MTA_CALLS>(std::calloc(stubCount, sizeof(MTAMGMT_MTA_CALLS))) : NULL;
+    for (ULONG i = 0; i < stubCount; i++)
+        std::snprintf(pEntry->pCalls[i].Codec, sizeof(pEntry->pCalls[i].Codec), "call%lu", i);
+    return RETURN_OK;
+}
+
+/* Tests */
+
+static void test_records_free_mta_log()
+{
+    stubStatus = RETURN_OK;
+    stubCount = 5;
+    auto log = mta_hal::get_mta_log();
+    CHECK(log);
+    CHECK(log->size() == 5);
+    ULONG i = 0;
+    for (const auto &entry : log->span())
+        CHECK(mta_hal::field(entry.EventLevel) == std::to_string(i++));
+}
+
+static void test_records_move()
+{
+    stubStatus = RETURN_OK;
+    stubCount = 3;
+    auto log = mta_hal::get_mta_log();
+    CHECK(log);
+    mta_hal::Records<MTAMGMT_MTA_MTALOG_FULL> moved = std::move(log).value();
+    CHECK(moved.size() == 3);
+
+    mta_hal::Records<MTAMGMT_MTA_MTALOG_FULL> other;
+    other = std::move(moved);
+    CHECK(moved.empty());
+    CHECK(other.size() == 3);
+
+    /* Assigning over a non-empty owner releases its array first. */
+    other = mta_hal::get_mta_log().value();
+    CHECK(other.size() == 3);
+    other.reset();
+    CHECK(other.empty());
+}
+
+static void test_records_empty()
+{
+    stubStatus = RETURN_OK;
+    stubCount = 0;
+    auto calls = mta_hal::get_calls(1);
+    CHECK(calls);
+    CHECK(calls->empty());
+    CHECK(calls->begin() == calls->end());
+}
+
+static void test_records_span()
+{
+    stubStatus = RETURN_OK;
+    stubCount = 2;
+    auto calls = mta_hal::get_calls(7);
+    CHECK(calls);
+    std::span<const MTAMGMT_MTA_CALLS> span = *calls;
+    CHECK(span.size() == 2);
+    CHECK(mta_hal::field(span[1].Codec) == "line7");
+}
+
+static void test_field_unterminated()
+{
+    stubStatus = RETURN_OK;
+    auto info = mta_hal::get_dhcp_info();
+    CHECK(info);
+    CHECK(mta_hal::field(info->FQDN).size() == sizeof(info->FQDN));
+}
+
+static void test_errors()
+{
+    stubStatus = RETURN_ERR;
+    auto log = mta_hal::get_mta_log();
+    CHECK(!log);
+    CHECK(log.error() == mta_hal::Error::Failed);
+
+    auto timedOut = mta_hal::get_calls(1, std::chrono::milliseconds(5));
+    CHECK(!timedOut);
+    CHECK(timedOut.error() == mta_hal::Error::Timeout);
+
+    auto failed = mta_hal::get_calls(1, std::chrono::milliseconds(50));
+    CHECK(failed.error() == mta_hal::Error::Failed);
+}
+
+static void test_line_table_entry_owns_calls()
+{
+    stubStatus = RETURN_OK;
+    stubCount = 3;
+    auto entry = mta_hal::get_line_table_entry(0);
+    CHECK(entry);
+    CHECK(entry->info.InstanceNumber == 1);
+    CHECK(entry->info.pCalls == NULL);
+    CHECK(entry->calls.size() == 3);
+    CHECK(mta_hal::field(entry->calls[2].Codec) == "call2");
+
+    /* Moving the entry moves the ownership of its calls. */
+    mta_hal::LineTableEntry moved = std::move(entry).value();
+    CHECK(moved.calls.size() == 3);
+
+    stubCount = 0;
+    auto empty = mta_hal::get_line_table_entry(1);
+    CHECK(empty && empty->calls.empty());
+
+    stubStatus = RETURN_ERR;
+    CHECK(mta_hal::get_line_table_entry(0).error() == mta_hal::Error::Failed);
+}
+
+static void test_timeout_clamped()
+{
+    stubStatus = RETURN_OK;
+    (void)mta_hal::get_calls(1, std::chrono::milliseconds(-1));
+    CHECK(stubTimeoutMs == 0);
+    (void)mta_hal::get_calls(1, std::chrono::milliseconds(1234));
+    CHECK(stubTimeoutMs == 1234);
+    /* 60 days do not fit in a 32-bit ULONG. */
+    (void)mta_hal::get_calls(1, std::chrono::hours(24 * 60));
+    CHECK(stubTimeoutMs == std::min<unsigned long long>(std::numeric_limits<ULONG>::max(), 24ULL * 60 * 3600 * 1000));
+    (void)mta_hal::get_calls(1, std::chrono::milliseconds::max());
+    CHECK(stubTimeoutMs == std::min<unsigned long long>(std::numeric_limits<ULONG>::max(), std::chrono::milliseconds::max().count()));
+}
+
+static void test_result_misuse_throws()
+{
+    stubStatus = RETURN_ERR;
+    auto info = mta_hal::get_dhcp_info();
+    bool thrown = false;
+    try
+    {
+        (void)info->FQDN;
+    }
+    catch (const std::bad_optional_access &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try
+    {
+        (void)info.value();
+    }
+    catch (const std::bad_optional_access &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+int main()
+{
+    test_records_free_mta_log();
+    test_records_move();
+    test_records_empty();
+    test_records_span();
+    test_field_unterminated();
+    test_errors();
+    test_line_table_entry_owns_calls();
+    test_timeout_clamped();
+    test_result_misuse_throws();
+
+    if (failures)
+    {
+        std::fprintf(stderr, "test_mta_hal_hpp: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("test_mta_hal_hpp: passed\n");
+    return 0;
+}
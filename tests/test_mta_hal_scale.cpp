@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file test_mta_hal_scale.cpp
+* @brief Scale tests of mta_hal_sim.h, run against the stub test backend.
+*
+* Each API is measured at every data size listed in mta_hal_sim.h, by the procedure described there.
+*/
+
+#include "stub_mta_hal_sim.hpp"
+#include "mta_hal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static const ULONG calls = 20;
+static const ULONG descriptionLen = 64;
+
+static void lift_retention_limits()
+{
+    MTAMGMT_MTA_RETENTION_LIMITS limits{};
+    CHECK(mta_hal_SetRetentionLimits(&limits) == RETURN_OK);
+}
+
+static MTA_HAL_SIM_SCENARIO scenario()
+{
+    MTA_HAL_SIM_SCENARIO s{};
+    s.Seed = 1;
+    s.Lines = 1;
+    s.MtaLogDescriptionLen = descriptionLen;
+    return s;
+}
+
+/* Call fn 20 times, checking the count, the memory overhead of each call and the 95th percentile latency. */
+template <typename T>
+static void measure(const char *name, ULONG n, ULONG ceilingUs, std::size_t arrayBytes, const std::function<INT(ULONG *, T **)> &fn)
+{
+    std::vector<long long> us;
+    for (ULONG i = 0; i < calls; i++)
+    {
+        MTAMGMT_MTA_MEMORY_USAGE before;
+        MTAMGMT_MTA_MEMORY_USAGE after;
+        CHECK(mta_hal_sim_ResetPeakMemoryUsage() == RETURN_OK);
+        CHECK(mta_hal_GetMemoryUsage(&before) == RETURN_OK);
+        ULONG count = 0;
+        T *data = nullptr;
+        auto start = std::chrono::steady_clock::now();
+        INT rc = fn(&count, &data);
+        auto end = std::chrono::steady_clock::now();
+        mta_hal::Records<T> records(data, count);
+        CHECK(mta_hal_GetMemoryUsage(&after) == RETURN_OK);
+
+        CHECK(rc == RETURN_OK);
+        CHECK(count == n);
+        CHECK(after.PeakTotalBytes - before.TotalBytes <= MTA_HAL_SIM_MAX_OVERHEAD_BYTES(arrayBytes));
+        CHECK(after.TotalBytes == before.TotalBytes);
+        us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::sort(us.begin(), us.end());
+    long long p95 = us[(calls * 95 + 99) / 100 - 1];
+    if (p95 > static_cast<long long>(ceilingUs))
+    {
+        std::fprintf(stderr, "%s(n=%lu): 95th percentile %lld us exceeds %lu us\n", name, n, p95, ceilingUs);
+        failures++;
+    }
+}
+
+static void test_get_calls()
+{
+    for (ULONG n : {10UL, 100UL, 1000UL, 10000UL})
+    {
+        auto s = scenario();
+        s.CallsPerLine = n;
+        CHECK(mta_hal_sim_LoadScenario(&s) == RETURN_OK);
+        measure<MTAMGMT_MTA_CALLS>("mta_hal_GetCalls", n, MTA_HAL_SIM_MAX_GET_CALLS_US(n), n * sizeof(MTAMGMT_MTA_CALLS),
+                                   [](ULONG *count, PMTAMGMT_MTA_CALLS *p) { return mta_hal_GetCalls(1, count, p); });
+    }
+}
+
+static void test_get_dsx_logs()
+{
+    for (ULONG n : {100UL, 1000UL, 10000UL, 50000UL})
+    {
+        auto s = scenario();
+        s.DSXLogEntries = n;
+        CHECK(mta_hal_sim_LoadScenario(&s) == RETURN_OK);
+        measure<MTAMGMT_MTA_DSXLOG>("mta_hal_GetDSXLogs", n, MTA_HAL_SIM_MAX_GET_DSX_LOGS_US(n), n * sizeof(MTAMGMT_MTA_DSXLOG),
+                                    mta_hal_GetDSXLogs);
+    }
+}
+
+static void test_get_mta_log()
+{
+    for (ULONG n : {100UL, 1000UL, 10000UL, 50000UL})
+    {
+        auto s = scenario();
+        s.MtaLogEntries = n;
+        CHECK(mta_hal_sim_LoadScenario(&s) == RETURN_OK);
+        measure<MTAMGMT_MTA_MTALOG_FULL>("mta_hal_GetMtaLog", n, MTA_HAL_SIM_MAX_GET_MTA_LOG_US(n),
+                                         n * (sizeof(MTAMGMT_MTA_MTALOG_FULL) + descriptionLen + 1), mta_hal_GetMtaLog);
+    }
+}
+
+static void test_get_service_flow()
+{
+    for (ULONG n : {16UL, 64UL, 256UL})
+    {
+        auto s = scenario();
+        s.ServiceFlows = n;
+        CHECK(mta_hal_sim_LoadScenario(&s) == RETURN_OK);
+        measure<MTAMGMT_MTA_SERVICE_FLOW>("mta_hal_GetServiceFlow", n, MTA_HAL_SIM_MAX_GET_SERVICE_FLOW_US(n),
+                                          n * sizeof(MTAMGMT_MTA_SERVICE_FLOW), mta_hal_GetServiceFlow);
+    }
+}
+
+/* Without lifting the caps, a scenario is trimmed to them like device history. */
+static void test_default_caps_trim()
+{
+    stub::history().init(1);
+    auto s = scenario();
+    s.CallsPerLine = 1000;
+    CHECK(mta_hal_sim_LoadScenario(&s) == RETURN_OK);
+    auto result = mta_hal::get_calls(1);
+    CHECK(result && result->size() == MTA_HAL_DEFAULT_MAX_CALLS_PER_LINE);
+}
+
+int main()
+{
+    test_default_caps_trim();
+
+    stub::history().init(1);
+    lift_retention_limits();
+    test_get_calls();
+    test_get_dsx_logs();
+    test_get_mta_log();
+    test_get_service_flow();
+
+    if (failures)
+    {
+        std::fprintf(stderr, "test_mta_hal_scale: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("test_mta_hal_scale: passed\n");
+    return 0;
+}